@@ -68,6 +68,10 @@ class HeapFile {
     
     // insert record into file
     Status insertRecord(char *recPtr, int recLen, RID& outRid); 
+
+    // insert record after every other record of the file, so that a scan
+    // returns records in the order they were appended
+    Status appendRecord(char *recPtr, int recLen, RID& outRid);
     
     // delete record from file
     Status deleteRecord(const RID& rid); 
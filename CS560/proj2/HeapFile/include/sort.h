@@ -0,0 +1,115 @@
+/*
+ * sort.h - external merge sort of a HeapFile
+ *
+ * Sort reads a heap file through a Scan and hands its records back in key
+ * order. Records carry no schema, so the key is described by its type
+ * (attrInteger, attrReal or attrString), its offset in the record and its
+ * length. Every record must be long enough to hold the key.
+ *
+ * The sort never keeps more than bufPages pages worth of records in
+ * memory. Runs are generated by replacement selection, so on random input
+ * they come out about twice that long. They are written to chains of
+ * HFPages that are not entered in the DB directory and are freed as they
+ * are read back. While there are more than bufPages - 1 runs, groups of
+ * that many are merged into longer runs; the last merge happens lazily,
+ * one record per getNext(), through a loser tree.
+ */
+
+#ifndef _SORT_H
+#define _SORT_H
+
+#include "minirel.h"
+#include "heapfile.h"
+
+enum sortErrCodes {
+    BAD_SORT_ORDER,
+    BAD_SORT_KEY,
+    BAD_BUFFER_COUNT,
+};
+
+class Sort {
+
+  public:
+
+    // Sorts the records of in on the key at keyOffset. order is Ascending
+    // or Descending, bufPages at least 3. Run generation and all merges
+    // but the last are done here.
+    Sort(HeapFile *in, AttrType keyType, int keyOffset, int keyLen,
+         TupleOrder order, int bufPages, Status& status);
+
+    // frees whatever is left of the runs
+    ~Sort();
+
+    // copy the next record in order to recPtr, DONE once all are returned
+    Status getNext(char *recPtr, int& recLen);
+
+    // append the records not yet returned to out, in order
+    Status writeTo(HeapFile *out);
+
+    // number of runs replacement selection produced
+    int initialRuns() { return numInitialRuns; }
+
+  private:
+
+    // one run being read back: its current page stays pinned
+    struct RunReader {
+        PageId  pageId;     // INVALID_PAGE once the run is used up
+        HFPage *page;
+        RID     rid;
+        char   *rec;        // the current record, on page
+        int     recLen;
+    };
+
+    // a run being written
+    struct RunWriter {
+        PageId  firstPageId;
+        PageId  pageId;
+        HFPage *page;
+    };
+
+    // a record of the replacement selection workspace
+    struct HeapEntry {
+        int   run;
+        char *rec;
+        int   recLen;
+    };
+
+    AttrType   keyType;
+    int        keyOffset;
+    int        keyLen;
+    TupleOrder order;
+    int        bufPages;
+
+    PageId    *runs;        // first page of every run
+    int        numRuns;
+    int        numInitialRuns;
+
+    // the final merge
+    RunReader *readers;
+    int       *tree;        // tree[0] is the winner, tree[1..k-1] the losers
+    int        numReaders;
+
+    int    compare(const char *rec1, const char *rec2);
+    bool   before(RunReader *r, int a, int b);
+
+    Status makeRuns(HeapFile *in);
+    Status mergePass();
+
+    bool      entryBefore(const HeapEntry& a, const HeapEntry& b);
+    void      push(HeapEntry *heap, int& n, const HeapEntry& e);
+    HeapEntry pop(HeapEntry *heap, int& n);
+
+    void   openWriter(RunWriter& w);
+    Status writeRecord(RunWriter& w, char *rec, int recLen);
+    void   closeWriter(RunWriter& w);
+
+    Status openReader(RunReader& r, PageId first);
+    Status advance(RunReader& r);
+    void   closeReader(RunReader& r);
+    void   destroyRun(PageId pid);
+
+    void   buildTree(RunReader *r, int *t, int k);
+    void   replay(RunReader *r, int *t, int k, int leaf);
+};
+
+#endif    // _SORT_H
@@ -0,0 +1,94 @@
+/*
+ * backup.h - online full and incremental backups of a database
+ *
+ * A full backup holds every allocated page of the database; an
+ * incremental one holds the pages written since the backup before it.
+ * The pages written are tracked in a ChangeMap, one bit per page in the
+ * file dbname-chg, which the buffer manager sets before it writes a page
+ * out (see BufMgr::enableChangeTracking()). A bit set and not followed
+ * by the write only puts a page in the next backup for nothing. The
+ * first full backup turns tracking on, and every backup clears the bits
+ * once it is on disk. Pages written behind the buffer manager's back,
+ * by a bulk loader with a PageIO of its own, must be noted with
+ * BufMgr::noteWritten().
+ *
+ * backupDatabase() runs while the database is open. It writes out the
+ * dirty pages first, then reads the pages it backs up from the files
+ * they live in, runs of consecutive pages of the DB file as one request
+ * each and many of them in flight on an io_uring (see pageio.h), and
+ * streams them to the backup file in page order. Changes of transactions
+ * that are open at the time are in the backup; recovery undoes them only
+ * if the log is kept with it.
+ *
+ * restoreDatabase() applies a backup to the open database through the
+ * buffer manager, in page order: a full one to a database created with
+ * the same number of pages, then the incremental ones in the order they
+ * were taken. Each backup file names the one it follows, and one out of
+ * order is refused. The pages of a tablespace come back with their
+ * allocation bits; a database restored into must have a tablespace if
+ * the backup has pages past the DB file.
+ */
+
+#ifndef _BACKUP_H
+#define _BACKUP_H
+
+#include "minirel.h"
+#include "page.h"
+
+enum backupErrCodes {
+    BACKUP_FILE_ERROR,
+    BACKUP_BAD_FILE,
+    BACKUP_NO_FULL,
+    BACKUP_OUT_OF_ORDER,
+    BACKUP_WRONG_DB,
+    BACKUP_CHANGE_FILE,
+};
+
+// what a backup file says about itself
+struct BackupInfo {
+    int   seq;          // backups are numbered from 1 in the order taken
+    int   prevSeq;      // the backup it follows, 0 for a full one
+    int   dbPages;      // pages of the DB file
+    int   numPages;     // of the database, with its tablespace
+    int   count;        // pages in the backup
+    lsn_t lsn;          // the end of the log when it was taken
+};
+
+class ChangeMap {
+
+  public:
+
+    // opens the change map of the DB dbname, or starts one with no
+    // pages changed and no backup taken
+    ChangeMap(const char *dbname, Status& status);
+    ~ChangeMap();
+
+    bool   changed(PageId pid)      { return pid >= 0 && pid < numBits && ((bits[pid / 8] >> (pid % 8)) & 1); }
+    Status mark(PageId pid);
+
+    // pages marked, and the number of the last backup, 0 for none
+    int    numChanged()             { return marked; }
+    int    lastBackup()             { return seq; }
+
+    // clear every bit after backup seq is on disk
+    Status reset(int seq);
+
+  private:
+    int    fd;
+    int    numBits;
+    int    marked;
+    int    seq;
+    unsigned char *bits;
+};
+
+// write a full backup of the open database to file, or the pages changed
+// since the last backup
+Status backupDatabase(const char *file, bool full, BackupInfo *info = NULL);
+
+// apply a backup to the open database
+Status restoreDatabase(const char *file, BackupInfo *info = NULL);
+
+// the header of a backup file
+Status readBackupInfo(const char *file, BackupInfo& info);
+
+#endif    // _BACKUP_H
@@ -98,11 +98,54 @@ struct KeyDataEntry
   Datatype   data;
 };
 
+/*
+ * Posting lists:
+ *
+ * A leaf holds each key once.  While only one data record has the key the
+ * entry is the usual <key, rid>.  Further rids turn it into a posting list
+ * entry <key, PostingHeader, encoded rids, marker>, where marker is a RID
+ * whose pageNo is BT_POSTING_PAGE and whose slotNo is the number of bytes
+ * between the key and the marker.  The header starts with the smallest
+ * rid of the list, so get_key_data hands that out as the entry's data
+ * just as it would for a plain <key, rid> entry.  See btposting.h for the
+ * encoding and the overflow pages.
+ */
+
+#define BT_POSTING_PAGE      -2
+
+struct PostingHeader
+{
+  RID    first;     // smallest rid in the list
+  int    count;     // number of rids in the list
+  PageId overflow;  // first overflow page, INVALID_PAGE if kept inline
+};
+
+/*
+ * Records:
+ *
+ * The leaves of a ClusteredFile (see clusteredfile.h) hold whole records
+ * rather than rids: <key, RecordHeader, record, marker>, where marker is a
+ * RID whose pageNo is BT_RECORD_PAGE and whose slotNo is the number of
+ * bytes between the key and the marker, laid out as for a posting list.
+ * A record too long to keep in the leaf goes to a run of overflow pages
+ * and the entry holds the header only, see btrecord.h.  get_key_data
+ * hands out the header as the entry's data.
+ */
+
+#define BT_RECORD_PAGE       -3
+
+struct RecordHeader
+{
+  int    length;    // bytes in the record
+  PageId overflow;  // first page of its run, INVALID_PAGE if kept inline
+};
+
 /*
  * Finally, here is the interface to our <key,data> abstraction.
  * 
  * keyCompare simply compares keys (types must be the same); return 
- * value is < 0, 0, or > 0.
+ * value is < 0, 0, or > 0.  Code that knows its key type at compile
+ * time can use BTKeyTraits<Key>::compare from btkey.h directly.
  *
  * make_entry packages a key and a data value into a chunk of memory 
  * large enough to hold it (the first parameter).  Note that the 
@@ -113,7 +156,8 @@ struct KeyDataEntry
  *
  * get_key_data takes a KeyDataEntry chunk and its real length and 
  * unpacks the <key,data> values from it; those are written to *targetkey
- * and *targetdata, respectively.
+ * and *targetdata, respectively.  For a posting list entry the data is
+ * the smallest rid of the list.
  *   - key1  < key2 : negative
  *   - key1 == key2 : 0
  *   - key1  > key2 : positive
@@ -147,6 +191,14 @@ void get_key_data(void *targetkey, Datatype *targetdata,
                   KeyDataEntry *psource, int entry_len, 
                   nodetype ndtype);
 
+/*
+ * get_entry_key_length: the number of bytes of a <key,data> pair that
+ * are its key, as get_key_data works it out.
+ */
+
+int get_entry_key_length(const KeyDataEntry *psource, int entry_len,
+                         nodetype ndtype);
+
 /*
  * get_key_length: return key length in given key_type
  */
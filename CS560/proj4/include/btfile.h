@@ -15,7 +15,13 @@
 #include "bt.h"
 
 // Define your error code for B+ tree here
-// enum btErrCodes  {...}
+enum btErrCodes {
+    BT_DUPLICATE_KEY,
+    BT_KEY_NOT_FOUND,
+};
+
+// number of index pages near the root that stay pinned while the file is open
+#define BT_PIN_CACHE 8
 
 class BTreeFile: public IndexFile
 {
@@ -41,7 +47,8 @@ class BTreeFile: public IndexFile
     // you need not implement merging of pages when occupancy
     // falls below the minimum threshold (unless you want extra credit!)
     
-    IndexFileScan *new_scan(const void *lo_key = NULL, const void *hi_key = NULL);
+    IndexFileScan *new_scan(const void *lo_key = NULL, const void *hi_key = NULL,
+                            TupleOrder order = Ascending, int limit = 0);
     // create a scan with given keys
     // Cases:
     //      (1) lo_key = NULL, hi_key = NULL
@@ -54,10 +61,33 @@ class BTreeFile: public IndexFile
     //              exact match ( might not unique)
     //      (5) lo_key!= NULL, hi_key!= NULL, lo_key < hi_key
     //              range scan from lo_key to hi_key
+    // with order = Descending the same range is returned from hi_key
+    // down to lo_key by following the leaves' prevPage links.
+    // limit is passed on to IndexFileScan::set_limit().
+
+    Status multiGet(const void *keys, int n, RID *out);
+    // look up n keys at once. keys holds n keys packed keysize() bytes
+    // apart, out[i] receives the data rid of the first entry equal to
+    // the i-th key, or [INVALID_PAGE, INVALID_SLOT] if there is none.
+    // the probes are sorted first so the tree is walked once, left to
+    // right, keeping the inner pages of the last descent pinned.
+
+    Status relocate(const void *keys, const RidMove *moves, int n);
+    // repoint n entries at records that moved, as HeapFile::vacuum()
+    // reports them: <i-th key, moves[i].oldRid> becomes <i-th key,
+    // moves[i].newRid>. keys are packed as for multiGet. each move is an
+    // insert of the new rid followed by a delete of the old one, so a
+    // failed insert leaves that entry unmoved; the moves are applied in key
+    // order, so consecutive moves find their pages still in the pool.
 
     int keysize();
     
-  private:
+  protected:
+    // puts <key, rid> into the leaf the descent of insert() ended at,
+    // returning DONE if it does not fit. a ClusteredFile puts records
+    // there instead.
+    virtual Status insert_leaf(BTLeafPage *page, const void *key, const RID rid);
+
     typedef struct headerInfo {
       PageId headerPid;
       PageId rootPid;
@@ -66,15 +96,42 @@ class BTreeFile: public IndexFile
       int height;
     } headerInfo;
 
-    headerInfo *header;
+    typedef struct pathEntry {
+      PageId pid;
+      BTIndexPage *page;
+    } pathEntry;
+
+    typedef struct cacheEntry {
+      PageId pid;
+      BTIndexPage *page;
+      int dirty;
+    } cacheEntry;
+
+    // header is a copy of the header record, read once when the file is
+    // opened and written back by write_header() whenever it changes.
+    // the root and up to BT_PIN_CACHE index pages of the level below it
+    // stay pinned, so descents do not go through the buffer manager for
+    // them. grow() lets go of the cached pages, as they are no longer on
+    // that level, and the rest is unpinned when the file is closed.
+    headerInfo header;
     BTIndexPage *rootPage;
+    cacheEntry pinCache[BT_PIN_CACHE];
+    int numCached;
     char *fileName;
+    Status write_header();
+    Status pin_index(int curr_level, PageId pid, BTIndexPage *&page);
+    Status unpin_index(PageId pid, int dirty);
+    Status release_cache();
+    Status release_pinned();
     Status destroy_helper(int curr_level, PageId curPid);
     Status insert_helper(int curr_level, PageId curPid, const void *key, const RID rid);
     Status delete_helper(int curr_level, PageId curPid, const void *key, const RID rid);
     Status grow(); // grows the root
+    int index_entry_room(); // free space a page needs to take one more index entry
     Status split(int curr_height, PageId parentPid, PageId childPid);
     Status search(int curr_level, PageId pid, const void *key, void *curr_key, RID &rid, RID &dataRid);
+    PageId descend(const void *key, pathEntry *path);
+    Status search_last(const void *key, void *curr_key, RID &rid, RID &dataRid);
     void debugPage(int curr_level, PageId pid);
     void debugPrivateVars();
 };
@@ -17,6 +17,7 @@
 class BTIndexPage : public SortedPage {
  private:
    // No private variables should be declared.
+   template <AttrType T> int find_child(const void *key);
 
  public:
 
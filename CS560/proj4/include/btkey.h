@@ -0,0 +1,100 @@
+/*
+ * btkey.h - compile time key types for the B+ tree.
+ *
+ * keyCompare() in bt.h looks at an AttrType on every call.  The traits
+ * below give each key type its own inline compare instead, so code that
+ * knows its key type at compile time gets the comparison inlined into
+ * its loops.  The page searches of BTreeFile switch on the AttrType once
+ * per search and then compare through BTEntryKey<T>, which reads the key
+ * of an entry straight out of its SortedPage record.
+ */
+
+#ifndef BTKEY_H
+#define BTKEY_H
+
+#include <string.h>
+
+#include "minirel.h"
+#include "bt.h"
+
+/*
+ * BTKeyTraits<Key>::compare returns < 0, 0 or > 0 like keyCompare.
+ */
+
+template <class Key>
+struct BTKeyTraits;
+
+// three way compare without the overflow of a subtraction
+template <class Key>
+inline int bt_ordered_compare(const Key &a, const Key &b)
+{
+  return (b < a) - (a < b);
+}
+
+template <>
+struct BTKeyTraits<int>
+{
+  static int compare(const int &a, const int &b) { return bt_ordered_compare(a, b); }
+};
+
+template <>
+struct BTKeyTraits<long long>
+{
+  static int compare(const long long &a, const long long &b) { return bt_ordered_compare(a, b); }
+};
+
+// NaN compares unequal to everything under <, so on its own it would be
+// "equal" to every key.  Instead all NaNs sort together after +inf.
+template <>
+struct BTKeyTraits<double>
+{
+  static int compare(const double &a, const double &b)
+  {
+    bool aNaN = a != a, bNaN = b != b;
+    if (aNaN || bNaN)
+      return (int)aNaN - (int)bNaN;
+    return bt_ordered_compare(a, b);
+  }
+};
+
+/*
+ * BTEntryKey<T>::compare(key, entry, entry_len, ndtype) compares a search
+ * key of type T, as handed to BTreeFile, with the key of the <key,data>
+ * record entry of a leaf or index page.  An integer key is stored as is;
+ * a string key is stored without its NUL (see make_entry), so it is
+ * compared bytewise up to the shorter of the two, like the bounded
+ * strncmp of keyCompare.
+ */
+
+template <AttrType T>
+struct BTEntryKey;
+
+template <>
+struct BTEntryKey<attrInteger>
+{
+  static int compare(const void *key, const char *entry, int, nodetype)
+  {
+    int k;
+    memcpy(&k, entry, sizeof(int));
+    return BTKeyTraits<int>::compare(*(const int *)key, k);
+  }
+};
+
+template <>
+struct BTEntryKey<attrString>
+{
+  static int compare(const void *key, const char *entry, int entry_len, nodetype ndtype)
+  {
+    const char *s = (const char *)key;
+    int len = strnlen(s, MAX_KEY_SIZE1);
+    int entryLen = get_entry_key_length((const KeyDataEntry *)entry, entry_len, ndtype);
+    if (entryLen > MAX_KEY_SIZE1)
+      entryLen = MAX_KEY_SIZE1;
+    int c = memcmp(s, entry, len < entryLen ? len : entryLen);
+    if (c != 0)
+      return c;
+    return bt_ordered_compare(len, entryLen);
+  }
+};
+
+#endif
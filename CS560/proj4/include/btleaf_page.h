@@ -20,6 +20,10 @@ class BTLeafPage : public SortedPage {
  private:
    // No private variables should be declared.
 
+   int find_slot(const void *key, AttrType key_type);
+   template <AttrType T> int find_slot_as(const void *key);
+   Status replace_entry(RID entryRid, const char *record, int record_length);
+
  public:
 
 
@@ -64,25 +68,70 @@ class BTLeafPage : public SortedPage {
    Status get_first(RID& rid, void *key, RID & dataRid);
    Status get_next (RID& rid, void *key, RID & dataRid);
 
+// get_last and get_prev walk the page the other way round, for
+// descending scans. get_last returns DONE on an empty page and
+// get_prev returns NOMORERECS once it is past the first pair.
+
+   Status get_last(RID& rid, void *key, RID & dataRid);
+   Status get_prev(RID& rid, void *key, RID & dataRid);
+
 
 // ------------------ get_data_rid -----------------------
-// This function performs a sequential search (or a
-// binary search if you are ambitious) to find a data entry
+// This function performs a binary search to find a data entry
 // of the form <key, dataRid>, where key is given in the call.
 // It returns the dataRid component of the pair; note that this
 // is the rid of the DATA record, and NOT the rid of the data entry!
+// For a posting list that is the smallest rid in it.
 
    Status get_data_rid(void *key, AttrType attrtype, RID & dataRid);
 
 
 // ------------------ get_entry_rid -----------------------
-// This function performs a sequential search (or a
-// binary search if you are ambitious) to find a data entry
+// This function performs a binary search to find a data entry
 // of the form <key, dataRid>, where key is given in the call.
-// It returns the rid corresponding to the pair.
+// It returns the rid corresponding to the pair, or FAIL if the
+// key is not on the page.
 
    Status get_entry_rid(void *key, AttrType attrtype, RID & entryRid);
 
+// ------------------ posting lists -----------------------
+// Each key is stored once, with all the dataRids that have it in a
+// posting list (see bt.h and btposting.h). add_posting adds a dataRid
+// to the entry at entryRid, returning DONE if the page is too full,
+// and remove_posting takes one out, returning DONE if it is not there.
+// The entry stays in its slot unless remove_posting deletes it.
+
+   Status add_posting(RID entryRid, AttrType key_type, RID dataRid);
+   Status remove_posting(RID entryRid, AttrType key_type, RID dataRid);
+
+// number of dataRids of the entry at entryRid, and all of them in rid
+// order, in an array the caller frees.
+
+   int posting_count(RID entryRid);
+   Status get_postings(RID entryRid, RID *& rids, int & count);
+
+// frees the overflow pages of the posting lists and records on this page
+
+   Status destroy_postings();
+
+// ------------------ records -----------------------
+// The leaves of a ClusteredFile hold whole records instead of dataRids
+// (see bt.h and btrecord.h). insert_record adds a <key, record> entry,
+// returning DONE if the page is too full to take it. get_record copies
+// the record of the entry at entryRid to rec, which needs room for
+// record_length(entryRid) bytes, and delete_record removes the entry
+// and frees its overflow pages. record_length is -1 for an entry that
+// is not a record. update_record swaps the record of the entry at
+// entryRid for rec, returning DONE, with the old one left in place, if
+// the page is too full to take it.
+
+   Status insert_record(const void *key, AttrType key_type,
+                        const char *rec, int recLen, RID& rid);
+   Status update_record(RID entryRid, const char *rec, int recLen);
+   int record_length(RID entryRid);
+   Status get_record(RID entryRid, char *rec, int & recLen);
+   Status delete_record(RID entryRid);
+
 
 };
 
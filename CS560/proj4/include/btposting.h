@@ -0,0 +1,71 @@
+/*
+ * btposting.h - posting lists for duplicate keys in B+ tree leaves.
+ *
+ * The payload of a posting list entry (see bt.h) is a PostingHeader,
+ * followed, while the list is small, by the rids themselves: sorted by
+ * page and then slot, and delta encoded as variable length integers.
+ * Each rid is written as the distance from the previous page number,
+ * followed by the distance from the previous slot number if the page is
+ * the same, or the plain slot number if it is not.  Rids of one data page
+ * thus usually take two bytes.
+ *
+ * A list that grows past BT_POSTING_INLINE bytes moves out of the leaf
+ * into a chain of overflow pages, and the payload shrinks to the header.
+ * Each overflow page holds a sorted run encoded the same way, starting
+ * over from [0,0], and the runs follow each other in rid order.  A list
+ * that shrinks to half a page of a single overflow page is moved back
+ * into the leaf.
+ */
+
+#ifndef BTPOSTING_H
+#define BTPOSTING_H
+
+#include "minirel.h"
+#include "page.h"
+#include "bt.h"
+
+// longest payload kept in the leaf itself
+#define BT_POSTING_INLINE    200
+
+// layout of an overflow page
+struct BTPostingPage
+{
+  PageId nextPage;   // next run of the list, INVALID_PAGE at the end
+  int    count;      // rids in this run
+  int    used;       // bytes of data in use
+  char   data[MAX_SPACE - 2 * sizeof(int) - sizeof(PageId)];
+};
+
+// orders rids by page and then slot, returns < 0, 0 or > 0
+int bt_rid_compare(const RID &a, const RID &b);
+
+// encodes n sorted rids into out, returns the number of bytes written.
+// out needs room for 10 bytes per rid.
+int bt_posting_encode(const RID *rids, int n, char *out);
+
+// decodes len bytes written by bt_posting_encode, returns the rid count
+int bt_posting_decode(const char *in, int len, RID *out);
+
+// builds the inline payload of a list of n sorted rids into payload,
+// which needs room for BT_POSTING_INLINE bytes. returns the payload
+// length, or -1 if the list does not fit inline.
+int bt_posting_make(char *payload, const RID *rids, int n);
+
+// reads the whole list into a malloc'ed array of count rids, the
+// caller frees it.
+Status bt_posting_read(const char *payload, int len, RID *&rids, int &count);
+
+// adds rid to the list. payload has room for BT_POSTING_INLINE bytes, len
+// is updated. returns DONE if the rid is already in the list.
+Status bt_posting_add(char *payload, int &len, RID rid);
+
+// removes rid from the list, found by binary search in the run that
+// holds it. returns DONE if the rid is not in the list. a list that has
+// shrunk enough is moved back inline if that grows the payload by no
+// more than room bytes.
+Status bt_posting_remove(char *payload, int &len, RID rid, int room);
+
+// frees the overflow pages of the list, if any
+Status bt_posting_destroy(const char *payload, int len);
+
+#endif
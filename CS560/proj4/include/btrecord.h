@@ -0,0 +1,41 @@
+/*
+ * btrecord.h - records kept in the leaves of a ClusteredFile.
+ *
+ * The payload of a record entry (see bt.h) is a RecordHeader followed by
+ * the record, as long as the record is no longer than BT_RECORD_INLINE
+ * bytes; that keeps at least three entries on a leaf, so a split always
+ * makes room.  A longer record is written to a run of consecutive
+ * overflow pages, MAX_SPACE bytes to a page with no header of their own,
+ * and the payload shrinks to the header, which names the first page of
+ * the run.  The run is allocated next to the leaf if there is room there.
+ */
+
+#ifndef BTRECORD_H
+#define BTRECORD_H
+
+#include "minirel.h"
+#include "page.h"
+#include "bt.h"
+
+// longest record kept in the leaf itself
+#define BT_RECORD_INLINE     240
+
+// length of the payload of a record of recLen bytes
+int bt_record_payload_length(int recLen);
+
+// builds the payload of rec into payload, which needs room for
+// bt_record_payload_length(recLen) bytes, writing out the overflow pages
+// first if it has to. hint is the page to put them next to.
+Status bt_record_make(char *payload, const char *rec, int recLen, PageId hint);
+
+// length of the record whose payload this is
+int bt_record_length(const char *payload);
+
+// copies the record out to rec, which needs room for
+// bt_record_length(payload) bytes, and sets recLen
+Status bt_record_read(const char *payload, char *rec, int &recLen);
+
+// frees the overflow pages of the record, if any
+Status bt_record_destroy(const char *payload);
+
+#endif
@@ -12,6 +12,9 @@ Status runTests();
  void test2();
  void test3();
  void test4();
+ void test5();
+ void test6();
+ void test7();
  void menu();
  void PrintInfo(BTreeFile* btf);
  void test_scan(IndexFileScan* scan);
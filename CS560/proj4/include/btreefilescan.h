@@ -20,11 +20,18 @@ public:
     // get the next record
     Status get_next(RID & rid, void* keyptr);
 
+    // for a scan of a ClusteredFile: the next key and its record, copied
+    // to rec, which needs room for the longest record in the range
+    Status get_next_record(void* keyptr, char *rec, int & recLen);
+
     // delete the record currently scanned
     Status delete_current();
 
     int keysize(); // size of the key
 
+    // stop after handing out limit more entries
+    void set_limit(int limit);
+
     // destructor
     ~BTreeFileScan();
 private:
@@ -38,6 +45,16 @@ private:
     BTLeafPage *curPage;  
     PageId curPid; 
     bool scanComplete;
+    TupleOrder order;
+    int limit;
+    int returned;
+    RID *postings;    // rids of the current entry if it has more than one
+    int numPostings;
+    int postPos;      // index of dataRid in postings
+
+    bool past_end();
+    void stop();
+    void load_postings();
 };
 
 #endif
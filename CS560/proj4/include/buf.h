@@ -22,9 +22,17 @@
 
 // You could add more enums for internal errors in the buffer manager.
 enum bufErrCodes  {HASHMEMORY, HASHDUPLICATEINSERT, HASHREMOVEERROR, HASHNOTFOUND, QMEMORYERROR, QEMPTY, INTERNALERROR, 
-			BUFFERFULL, BUFMGRMEMORYERROR, BUFFERPAGENOTFOUND, BUFFERPAGENOTPINNED, BUFFERPAGEPINNED};
+			BUFFERFULL, BUFMGRMEMORYERROR, BUFFERPAGENOTFOUND, BUFFERPAGENOTPINNED, BUFFERPAGEPINNED,
+			BUFFERMAPFAILED, BUFFERCHECKSUMFILE, BUFFERBADCHECKSUM, BUFFERZIPFILE, BUFFERZIPDAMAGED,
+			BUFFERAIOFAILED, BUFFERAIOFULL, BUFFERAIOERROR};
+
+// access patterns for adviseAccess()
+enum bufAccess {ACCESS_NORMAL, ACCESS_SEQUENTIAL, ACCESS_RANDOM};
 
 class Replacer; // may not be necessary as described below in the constructor
+class PageZip;
+class PageIO;
+class ChangeMap;
 
 
 typedef int FrameId;
@@ -40,6 +48,9 @@ private:
         bool dirty;
         PageId pageId;
         int pincount;  
+        lsn_t recLSN;   // first log record that dirtied the page, 0 if none
+        lsn_t pageLSN;  // last one, the log must be on disk up to it
+        bool ioPending; // an asynchronous read or write holds a pin on it
     } frame;
 
     typedef struct hashEntry {
@@ -57,11 +68,40 @@ private:
     int b;
     void updateFrameId(int numBuffers, int *&whenUsed, int id);
     int deleteFrameId(int numBuffers, int *&whenUsed, int id);
-    int locateReplacee();
+    int locateReplacee(int bucket);
     int  deleteFrameId(int id);
     void updateFrameId(int id);
     void debugFrames();
     void swapUsed(int frame1, int frame2);
+    Status writeFrame(int id);
+    Status prepareWrite(int id);
+    int lookup(PageId pid);
+    int claimFrame(PageId pid, Status& rc);
+
+    // the DB file mapped read-only, NULL unless mapDB() was called
+    char *mapped;
+    int mappedPages;
+
+    // two CRCs per page, the last one written and the one before it, 0
+    // for none; NULL unless enableChecksums() was called
+    unsigned int *checksums;
+    int checksumFd;
+    int checksumPages;
+    Status verifyFrame(int id);
+
+    // the compressed page store, NULL unless enableCompression() was called
+    PageZip *zip;
+    Status readFrame(int id);
+
+    // asynchronous reads and writes, NULL unless enableAsyncIO() was called
+    PageIO *aio;
+
+    // the pages written since the last backup, NULL unless
+    // enableChangeTracking() was called
+    ChangeMap *changes;
+    Status reapIO(int min);
+    Status waitFrame(int id);
+    void dropFrame(int id);
 
 public:
     Page* bufPool; // The actual buffer pool
@@ -87,8 +127,10 @@ public:
         // put it in a group of replacement candidates.
         // if pincount=0 before this call, return error.
 
-    Status newPage(PageId& firstPageId, Page*& firstpage, int howmany=1); 
-        // call DB object to allocate a run of new pages and 
+    Status newPage(PageId& firstPageId, Page*& firstpage, int howmany=1,
+                   PageId hint=INVALID_PAGE); 
+        // call the space map to allocate a run of new pages, close
+        // after hint if there is room, and
         // find a frame in the buffer pool for the first page
         // and pin it. If buffer is full, ask DB to deallocate 
         // all these pages and return error
@@ -119,6 +161,130 @@ public:
     unsigned int getNumUnpinnedBuffers();
 	// Get number of unpinned buffers
 
+    bool inPool(Page *page);
+	// Whether page is one of the buffer pool frames
+
+    void noteUpdate(Page *page, lsn_t lsn);
+	// Called by the log manager after it logged a change to page, which
+	// must be in the pool. The page is dirty from now on.
+
+    Status flushDirtyPages();
+	// Write out every dirty page, pinned or not, and keep it in the pool
+
+    int dirtyPages(PageId *pages, lsn_t *recLSNs, int max);
+	// Fill in up to max dirty pages with their recLSN, for a checkpoint.
+	// Returns how many there are.
+
+    /*** Read-only pins on a mapped DB file ***/
+    Status mapDB(const char *dbname);
+	// Map the DB file. From then on a read-only pin of a page that is not
+	// in the pool points straight into the mapping and costs no read and
+	// no frame. The mapping is never written: pages that are changed go
+	// through pinPage() and a frame as before, and readers see them there
+	// until they are written back to the file.
+
+    void unmapDB();
+
+    bool isMapped() const { return mapped != NULL; }
+
+    void adviseAccess(bufAccess pattern);
+	// Tell the kernel how the mapping is going to be read
+
+    Status pinPageReadOnly(PageId pid, Page*& page);
+	// Like pinPage() for a page that will only be read; the frame of the
+	// page if it is in the pool, else the mapped page if the DB is mapped
+
+    Status unpinPageReadOnly(PageId pid, Page *page);
+	// Release a page from pinPageReadOnly()
+
+    /*** Page checksums ***/
+    Status enableChecksums(const char *dbname);
+	// Keep a CRC-32C of every page the buffer manager writes in the file
+	// dbname-crc and check pages against it as they are read. The new
+	// CRC is written to that file before the page is written to the DB,
+	// and the one before it is kept, so a page that matches neither was
+	// damaged on disk; pinPage() then fails with BUFFERBADCHECKSUM.
+	// Neither file is forced to disk, so a page torn by a crash is only
+	// caught if the system kept the two writes in that order.
+	// Pages written before checksums were enabled are not checked until
+	// they are written again, and neither are mapped read-only pins.
+
+    void disableChecksums();
+
+    bool checksumsEnabled() const { return checksums != NULL; }
+
+    /*** Compressed pages ***/
+    Status enableCompression(const char *dbname);
+	// Open the compressed page store of the DB, see pagezip.h. Pages that
+	// are marked compressed are read from and written to the store, the
+	// frames in the pool hold them uncompressed. Mapped read-only pins of
+	// such pages go through a frame. A database that has a store is
+	// opened with it, before recovery reads any page.
+
+    Status disableCompression();
+	// Write out the dirty frames of compressed pages and close the store.
+	// The pages stay in the store; it must be enabled again before they
+	// are read.
+
+    bool compressionEnabled() const { return zip != NULL; }
+
+    bool isCompressed(PageId pid);
+
+    Status setCompressed(PageId pid, bool on);
+	// Mark pid compressed or not; a page that is no longer compressed is
+	// moved back to the DB file
+
+    Status dropCompressed(PageId start, int runSize = 1);
+	// Forget the compressed copies of pages that were freed
+
+    /*** Asynchronous I/O ***/
+    Status enableAsyncIO(const char *dbname, int depth = 64);
+	// Open an io_uring on the DB file with up to depth requests in
+	// flight, see pageio.h, and register the pool with it.
+
+    void disableAsyncIO();
+	// Wait for the requests in flight and close the ring
+
+    bool asyncIOEnabled() const { return aio != NULL; }
+
+    Status prefetch(const PageId *pids, int n);
+	// Start reading the pages that are not in the pool into free or
+	// replaceable frames and return at once. A frame being read holds a
+	// pin; pinPage() of its page waits for the read. Stops early when no
+	// frame is free. Compressed pages and pages in the segments of a
+	// tablespace are not read ahead. Does nothing without asynchronous
+	// I/O.
+
+    Status flushDirtyPagesAsync();
+	// Start writing every dirty page that is not pinned and return at
+	// once; the frames keep their pages. The log is forced first and
+	// checksums are kept as for a synchronous write. A page stays in the
+	// recLSN list of a checkpoint until its write completes. Compressed
+	// pages and pages in segments are written before it returns. Without
+	// asynchronous I/O this is flushDirtyPages().
+
+    Status completeIO(bool wait = true);
+	// Collect the reads and writes that have completed, and wait for
+	// the rest if wait is true. Fails with BUFFERAIOERROR if one failed;
+	// a page that was not read is dropped from the pool, a page that was
+	// not written is dirty again.
+
+    /*** Backups ***/
+    Status enableChangeTracking(const char *dbname);
+	// Mark every page in the change map of the DB, see backup.h, before
+	// it is written out
+
+    void disableChangeTracking();
+
+    ChangeMap *changeMap() { return changes; }
+
+    Status noteWritten(PageId start, int runSize = 1);
+	// Mark pages that were written without the buffer manager
+
+    Status readPage(PageId pid, Page *page);
+	// Read pid from where it lives, the DB file, the compressed store or
+	// a segment, without a frame. A dirty frame of it is newer.
+
 };
 
 #endif
@@ -0,0 +1,187 @@
+/*
+ * catalog.h - relation and index metadata with statistics
+ *
+ * The catalog keeps three heap files in the database: relcat with a
+ * RelDesc per relation, attrcat with an AttrDesc per attribute and
+ * indexcat with an IndexDesc per index. All of it is read into memory
+ * when the catalog is opened and kept there, hashed by relation name, so
+ * a lookup costs one hash probe; changes are written through to the heap
+ * files.
+ *
+ * analyze() gathers the statistics of a relation: its cardinality and
+ * pages from the heap file directory, and per attribute the number of
+ * distinct values and an equi-depth histogram. It reads a random share
+ * of the data pages, all of them by default. Distinct values are counted
+ * with a HyperLogLog sketch of the records read; when only a sample was
+ * read that count is scaled up to the relation with the Duj1 estimator,
+ * using the values seen once in the sample. Histograms are built from a
+ * reservoir sample of at most CAT_SAMPLE values of each integer or real
+ * attribute. The buckets hold the cardinality in equal shares; after a
+ * sample their outer bounds are widened by the records of the pages
+ * before the first page read and after the last, where the smallest and
+ * largest values of a file loaded in order are.
+ *
+ * The estimates are for a query planner: how many records a selection
+ * returns, and whether an index on the attribute reads fewer pages than
+ * a scan of the heap file would.
+ *
+ * The catalog is opened on first use, see MINIBASE_CATALOG.
+ */
+
+#ifndef _CATALOG_H
+#define _CATALOG_H
+
+#include <stdint.h>
+
+#include "minirel.h"
+#include "heapfile.h"
+
+// buckets of an equi-depth histogram
+#define CAT_HIST_BUCKETS 16
+
+// values of each attribute kept for the histogram
+#define CAT_SAMPLE       4096
+
+// HyperLogLog registers, 2^CAT_HLL_BITS of them
+#define CAT_HLL_BITS     10
+
+enum catErrCodes {
+    CAT_BAD_NAME,
+    CAT_REL_EXISTS,
+    CAT_REL_NOT_FOUND,
+    CAT_ATTR_NOT_FOUND,
+    CAT_INDEX_EXISTS,
+    CAT_INDEX_NOT_FOUND,
+    CAT_BAD_ATTR,
+    CAT_BAD_SCHEMA,
+    CAT_BAD_VALUE,
+};
+
+// a relation, in relcat
+struct RelDesc {
+    char   relName[MAXFILENAME + 1];
+    int    numAttrs;
+    int    numIndexes;
+    int    analyzed;        // whether the statistics below are set
+    double cardinality;
+    int    numPages;        // data pages of the heap file
+    double sampled;         // share of the pages analyze() read
+};
+
+// an attribute, in attrcat
+struct AttrDesc {
+    char     relName[MAXFILENAME + 1];
+    char     attrName[MAXATTRNAME + 1];
+    int      attrNo;
+    AttrType type;          // attrInteger, attrReal or attrString
+    int      offset;
+    int      len;
+    double   distinct;      // distinct values, 0 until analyzed
+    double   minVal;        // of integer and real attributes
+    double   maxVal;
+    int      numBuckets;    // of the histogram, 0 if there is none
+    double   bounds[CAT_HIST_BUCKETS + 1];   // bucket i is [bounds[i], bounds[i+1]]
+};
+
+// an index, in indexcat
+struct IndexDesc {
+    char      relName[MAXFILENAME + 1];
+    char      attrName[MAXATTRNAME + 1];
+    char      indexName[MAXINDEXNAME + 1];
+    IndexType kind;         // B_Index or Hash
+};
+
+// counts distinct values in 2^CAT_HLL_BITS bytes
+class HyperLogLog {
+
+  public:
+
+    HyperLogLog()                  { clear(); }
+
+    void   clear();
+    void   add(uint64_t hash);
+    void   addValue(const char *value, int len);
+    double estimate();
+
+    static uint64_t hash(const char *value, int len);
+
+  private:
+    unsigned char registers[1 << CAT_HLL_BITS];
+};
+
+class Catalog {
+
+  public:
+
+    // opens the catalog of the database, creating its files if needed
+    Catalog(Status& status);
+    ~Catalog();
+
+    // adds a relation stored in the heap file relName
+    Status createRel(const char *relName, int numAttrs, const AttrDesc *attrs);
+
+    // drops a relation and its indexes from the catalog; the files are
+    // left alone
+    Status destroyRel(const char *relName);
+
+    Status addIndex(const char *relName, const char *attrName,
+                    const char *indexName, IndexType kind);
+    Status dropIndex(const char *relName, const char *indexName);
+
+    // the relation, its attributes and indexes; NULL if there is none.
+    // The descriptions belong to the catalog.
+    const RelDesc   *getRel(const char *relName);
+    const AttrDesc  *getAttr(const char *relName, const char *attrName);
+    const IndexDesc *getIndex(const char *relName, const char *attrName);
+    const AttrDesc  *getAttrs(const char *relName, int& numAttrs);
+
+    // gathers the statistics of relName reading the given share of its
+    // data pages, picked at random with seed
+    Status analyze(const char *relName, double sampleFraction = 1.0,
+                   unsigned seed = 1);
+
+    // estimated records of relName with attrName = value, and with
+    // lo <= attrName <= hi (for integer and real attributes); the
+    // cardinality if the attribute was not analyzed. Equality uses the
+    // histogram where there is one, so values frequent enough to fill
+    // buckets are seen; a sample never rules out a value that it missed.
+    double estimateEq(const char *relName, const char *attrName, double value);
+    double estimateRange(const char *relName, const char *attrName,
+                         double lo, double hi);
+
+    // whether reading the records with lo <= attrName <= hi through an
+    // index on attrName reads fewer pages than a scan of the relation:
+    // a B+ tree costs its descent and a page per record, as the records
+    // are in no particular order
+    bool   preferIndex(const char *relName, const char *attrName,
+                       double lo, double hi);
+
+  private:
+    struct RelEntry {
+        RelDesc    rel;
+        RID        relRid;
+        AttrDesc  *attrs;
+        RID       *attrRids;
+        IndexDesc *indexes;
+        RID       *indexRids;
+        RelEntry  *next;       // in its hash chain
+    };
+
+    HeapFile  *relcat;
+    HeapFile  *attrcat;
+    HeapFile  *indexcat;
+
+    RelEntry **buckets;
+    int        numBuckets;
+    int        numRels;
+
+    RelEntry *find(const char *relName);
+    void      insertEntry(RelEntry *e);
+    void      removeEntry(RelEntry *e);
+    void      grow();
+    void      freeEntry(RelEntry *e);
+    Status    load();
+    Status    saveRel(RelEntry *e);
+};
+
+#endif    // _CATALOG_H
@@ -0,0 +1,112 @@
+/*
+ * clusteredfile.h - index-organized tables on top of BTreeFile.
+ *
+ * A ClusteredFile keeps whole records in the leaves of a B+ tree, sorted
+ * by their primary key, rather than <key, rid> entries pointing into a
+ * heap file: a lookup is one descent with no getRecord() after it, and a
+ * range scan on the primary key reads the leaves one after the other.
+ * Records longer than BT_RECORD_INLINE bytes live on overflow pages next
+ * to their leaf (see btrecord.h). The tree is the BTreeFile one, inner
+ * pages, splits and scans included; keys are unique, and rids have no
+ * place in it, so insert() and Delete() are private to a ClusteredFile.
+ *
+ * A SecondaryIndex maps another attribute of the records to the primary
+ * keys of the records that have it, rather than to where the records
+ * are, so nothing needs repointing when a leaf splits. It is a
+ * ClusteredFile itself, whose record for a secondary key is the list of
+ * primary keys; the caller keeps it in step with the table.
+ */
+
+#ifndef CLUSTEREDFILE_H
+#define CLUSTEREDFILE_H
+
+#include "btfile.h"
+#include "btrecord.h"
+
+class ClusteredFile : public BTreeFile
+{
+  public:
+    // opens the file, which should already exist
+    ClusteredFile(Status& status, const char *filename);
+
+    // creates it, keyed on keysize bytes of type keytype
+    ClusteredFile(Status& status, const char *filename, const AttrType keytype,
+                  const int keysize);
+
+    // adds a record under key, which must not be in the file yet
+    Status insertRecord(const void *key, const char *recPtr, int recLen);
+
+    // copies the record of key to recPtr, which needs room for
+    // recordLength() bytes
+    Status getRecord(const void *key, char *recPtr, int& recLen);
+    Status recordLength(const void *key, int& recLen);
+
+    // replaces the record of key
+    Status updateRecord(const void *key, const char *recPtr, int recLen);
+
+    Status deleteRecord(const void *key);
+
+    // the records from lo_key to hi_key, through
+    // BTreeFileScan::get_next_record(); see new_scan() for the bounds
+    BTreeFileScan *openScan(const void *lo_key = NULL, const void *hi_key = NULL,
+                            TupleOrder order = Ascending);
+
+    AttrType keytype() { return header.keyType; }
+
+  protected:
+    Status insert_leaf(BTLeafPage *page, const void *key, const RID rid);
+
+  private:
+    friend class SecondaryIndex;
+
+    // rids have no place in a ClusteredFile, see insertRecord() and
+    // deleteRecord()
+    using BTreeFile::insert;
+    using BTreeFile::Delete;
+
+    // the record insertRecord() or updateRecord() is putting in, for
+    // insert_leaf()
+    const char *pendingRec;
+    int pendingLen;
+    bool pendingUpdate;
+
+    // pins the leaf key belongs on and finds its entry there, returning
+    // DONE if it is not on it. the leaf is left pinned either way, pid is
+    // INVALID_PAGE if the file is empty.
+    Status find(const void *key, PageId& pid, BTLeafPage *&leaf, RID& entryRid);
+};
+
+class SecondaryIndex
+{
+  public:
+    // opens the index filename over table
+    SecondaryIndex(Status& status, const char *filename, ClusteredFile *table);
+
+    // creates it, keyed on keysize bytes of type keytype
+    SecondaryIndex(Status& status, const char *filename, ClusteredFile *table,
+                   const AttrType keytype, const int keysize);
+
+    ~SecondaryIndex();
+
+    Status destroyFile();
+
+    // notes that the record with primary key pkey has secondary key key,
+    // or no longer has it
+    Status insert(const void *key, const void *pkey);
+    Status Delete(const void *key, const void *pkey);
+
+    // the primary keys of the records with key, packed table->keysize()
+    // bytes apart in an array the caller frees. count is 0, and pkeys
+    // NULL, if there are none.
+    Status lookup(const void *key, char *&pkeys, int& count);
+
+  private:
+    ClusteredFile *file;
+    ClusteredFile *table;
+
+    // the list of key, malloc'ed with room for one more primary key.
+    // returns DONE if key has none.
+    Status read_list(const void *key, char *&pkeys, int& count);
+};
+
+#endif
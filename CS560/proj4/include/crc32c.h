@@ -0,0 +1,19 @@
+/*
+ * crc32c.h - CRC-32C (Castagnoli) checksums
+ *
+ * Uses the SSE4.2 crc32 instruction when the CPU has it, eight bytes at
+ * a time, folding with VPCLMULQDQ on AVX-512 when it has that too, and a
+ * slicing-by-8 table lookup otherwise. All give the same values as the
+ * iSCSI / ext4 CRC-32C.
+ */
+
+#ifndef _CRC32C_H
+#define _CRC32C_H
+
+// the CRC of len bytes of data, continuing from crc, 0 to start
+unsigned int crc32c(const void *data, int len, unsigned int crc = 0);
+
+// whether the hardware instruction is used
+bool crc32cHardware();
+
+#endif    // _CRC32C_H
@@ -0,0 +1,532 @@
+/*
+ * executor.h - iterator model query executor
+ *
+ * A query plan is a tree of Iterators built by hand: the leaves read
+ * HeapFiles, either sequentially or through a BTreeFile, and every other
+ * operator pulls tuples from its children. Tuples travel in TupleBatches
+ * of up to EXEC_BATCH_SIZE, so a next() call costs one virtual call per
+ * batch instead of one per tuple.
+ *
+ * Records carry no schema. A field is described by a FieldDesc, its type,
+ * offset and length in the tuple; Schema::fieldDesc() gives the one of a
+ * fixed field of a tuple laid out by a schema, see tuple.h. Every iterator has a width, the longest
+ * tuple it can return; a join returns the outer tuple padded out to the
+ * outer width followed by the inner tuple, so the inner fields of a join
+ * result sit at outer width + their offset.
+ *
+ * An iterator owns its children and deletes them with itself. open() may
+ * be called again after close(), which is how the nested loop join
+ * rescans its inner input, and close() more than once.
+ *
+ * The hash operators can spread their work over threads. The buffer
+ * manager is not thread-safe: only the thread calling open() and next()
+ * reads and writes heap files, the others work on memory.
+ */
+
+#ifndef _EXECUTOR_H
+#define _EXECUTOR_H
+
+#include "minirel.h"
+#include "heapfile.h"
+#include "sort.h"
+#include "btfile.h"
+#include "tuple.h"
+#include "pagefilter.h"
+
+// tuples per batch
+#define EXEC_BATCH_SIZE 64
+
+// tuples the hash operators take from their input before they share the
+// work on them out between threads
+#define EXEC_MORSEL     4096
+
+// the hash operators cluster their tables in partitions by this many
+// bits of the hash at a time
+#define EXEC_RADIX_BITS 6
+
+// levels of partitions the hash operators split a partition that is too
+// big for their buffer pages down to, each level by a hash of its own
+#define EXEC_MAX_LEVEL  32
+
+enum execErrCodes {
+    BAD_EXEC_WIDTH,
+    BAD_EXEC_FIELD,
+    BAD_EXEC_BUFFERS,
+    BAD_EXEC_MEMORY,
+};
+
+// one term of a conjunctive condition: left <op> value if value is
+// non-NULL, else left <op> right. In a join left is a field of the outer
+// tuple and right one of the inner tuple; in a filter both are fields of
+// the same tuple.
+struct CondExpr {
+    AttrOperator op;    // aopEQ, aopLT, aopGT, aopNE, aopLE or aopGE
+    FieldDesc    left;
+    FieldDesc    right;
+    const void  *value;
+};
+
+// compares two field values of the given type, <0, 0 or >0
+int compareField(const char *a, const char *b, const FieldDesc& f);
+
+// whether both tuples satisfy all n terms of conds
+bool evalConds(const CondExpr *conds, int n, const char *t1, const char *t2);
+
+class TupleBatch {
+
+  public:
+
+    TupleBatch(int width);
+    ~TupleBatch();
+
+    int   count()                { return numTuples; }
+    bool  full()                 { return numTuples == EXEC_BATCH_SIZE; }
+    void  clear()                { numTuples = 0; }
+    char *tuple(int i)           { return data + i * width; }
+    int   length(int i)          { return lens[i]; }
+
+    // room for one more tuple of len bytes, the caller fills it in
+    char *append(int len);
+
+  private:
+    int   width;
+    int   numTuples;
+    char *data;
+    int   lens[EXEC_BATCH_SIZE];
+};
+
+class Iterator {
+
+  public:
+
+    virtual ~Iterator() {}
+
+    virtual Status open() = 0;
+
+    // replace the contents of batch with the next tuples. Returns DONE,
+    // with batch empty, once there are none left.
+    virtual Status next(TupleBatch& batch) = 0;
+
+    virtual void close() = 0;
+
+    // the longest tuple next() can return
+    int tupleLen() { return width; }
+
+  protected:
+    int width;
+};
+
+// every record of a heap file, in file order. With pred, only those that
+// satisfy it, filtered a page at a time; see pagefilter.h.
+class FileScan : public Iterator {
+
+  public:
+    FileScan(HeapFile *file, int width, const PagePredicate *pred = NULL);
+    ~FileScan();
+
+    Status open();
+    Status next(TupleBatch& batch);
+    void   close();
+
+  private:
+    HeapFile     *file;
+    Scan         *scan;
+    bool          filtered;
+    PagePredicate pred;
+};
+
+// the records of a heap file whose key lies in [lo, hi] of a B+ tree on
+// it, in key order. A NULL bound leaves that end open.
+class IndexScan : public Iterator {
+
+  public:
+    IndexScan(BTreeFile *index, HeapFile *file, int width,
+              const void *lo, const void *hi);
+    ~IndexScan();
+
+    Status open();
+    Status next(TupleBatch& batch);
+    void   close();
+
+  private:
+    BTreeFile     *index;
+    HeapFile      *file;
+    IndexFileScan *scan;
+    char          *lo;      // copies of the bounds, NULL if open
+    char          *hi;
+    char          *key;
+};
+
+// the tuples of child that satisfy all n conditions
+class Filter : public Iterator {
+
+  public:
+    Filter(Iterator *child, const CondExpr *conds, int n);
+    ~Filter();
+
+    Status open();
+    Status next(TupleBatch& batch);
+    void   close();
+
+  private:
+    Iterator   *child;
+    CondExpr   *conds;
+    int         numConds;
+    TupleBatch  in;
+    int         pos;        // next tuple of in to look at
+};
+
+// the n fields of every tuple of child, packed one after the other. Fields
+// next to each other in child stay so and are copied together, as runs.
+class Project : public Iterator {
+
+  public:
+    Project(Iterator *child, const FieldDesc *fields, int n);
+    ~Project();
+
+    Status open();
+    Status next(TupleBatch& batch);
+    void   close();
+
+  private:
+    Iterator   *child;
+    FieldDesc  *fields;
+    int         numFields;
+    FieldDesc  *runs;
+    int         numRuns;
+    TupleBatch  in;
+};
+
+// block nested loop join: bufPages pages of outer tuples are read at a
+// time and inner is rescanned once per block
+class NestedLoopJoin : public Iterator {
+
+  public:
+    NestedLoopJoin(Iterator *outer, Iterator *inner,
+                   const CondExpr *conds, int n, int bufPages);
+    ~NestedLoopJoin();
+
+    Status open();
+    Status next(TupleBatch& batch);
+    void   close();
+
+  private:
+    Iterator   *outer;
+    Iterator   *inner;
+    CondExpr   *conds;
+    int         numConds;
+
+    char       *block;      // the current block of outer tuples
+    int        *blockLens;
+    int         blockCap;
+    int         blockCount;
+    int         blockPos;
+    TupleBatch  out;        // outer tuples not yet in a block
+    int         outPos;
+    bool        outerDone;
+
+    TupleBatch  in;         // the current batch of inner tuples
+    int         inPos;
+    bool        innerOpen;
+
+    Status nextBlock();
+};
+
+// for every outer tuple, the records of file whose key in index equals
+// outerKey, joined on the n further conditions
+class IndexNestedLoopJoin : public Iterator {
+
+  public:
+    IndexNestedLoopJoin(Iterator *outer, const FieldDesc& outerKey,
+                        BTreeFile *index, HeapFile *file, int innerWidth,
+                        const CondExpr *conds, int n);
+    ~IndexNestedLoopJoin();
+
+    Status open();
+    Status next(TupleBatch& batch);
+    void   close();
+
+  private:
+    Iterator      *outer;
+    FieldDesc      outerKey;
+    BTreeFile     *index;
+    HeapFile      *file;
+    int            innerWidth;
+    CondExpr      *conds;
+    int            numConds;
+
+    TupleBatch     in;
+    int            inPos;       // outer tuple the probe belongs to
+    bool           outerDone;
+    IndexFileScan *probe;       // NULL between outer tuples
+    char          *key;
+    char          *rec;
+};
+
+// equijoin on outerKey = innerKey. Both inputs are spooled to temporary
+// heap files and put through Sort with bufPages pages each; the inner
+// tuples of one key value are kept in memory while the outer tuples of
+// that value go by.
+class SortMergeJoin : public Iterator {
+
+  public:
+    SortMergeJoin(Iterator *outer, Iterator *inner, const FieldDesc& outerKey,
+                  const FieldDesc& innerKey, int bufPages);
+    ~SortMergeJoin();
+
+    Status open();
+    Status next(TupleBatch& batch);
+    void   close();
+
+  private:
+    Iterator  *outer;
+    Iterator  *inner;
+    FieldDesc  outerKey;
+    FieldDesc  innerKey;
+    int        bufPages;
+
+    Sort      *outerSort;
+    Sort      *innerSort;
+
+    char      *outerRec;
+    int        outerLen;
+    bool       outerDone;
+    char      *innerRec;        // the first inner tuple past the group
+    int        innerLen;
+    bool       innerDone;
+
+    char      *group;           // inner tuples with the same key
+    int       *groupLens;
+    int        groupCap;
+    int        groupCount;
+    int        groupPos;
+
+    Status fillGroup();
+};
+
+// grace hash join, equijoin on outerKey = innerKey. The inner input is
+// the build side. If it fits in bufPages pages it is hashed in memory and
+// the outer tuples probe it as they come; otherwise both inputs are
+// split into bufPages - 1 partitions on temporary heap files and each
+// pair of partitions is joined in turn. bufPages 0 takes the frames of
+// the buffer pool that are unpinned when the join is opened.
+//
+// A pair whose inner partition does not fit either is split again, by a
+// hash with another seed, down to EXEC_MAX_LEVEL levels. One that the
+// split does not spread, most of it a single key, is joined a table's
+// worth of inner tuples at a time, reading the outer partition once for
+// each.
+//
+// The table keeps the build tuples in bucket order, each with its hash,
+// so a probe reads one run of memory. They are put in that order by
+// radix partitioning, in two passes on the top bits of the hash with at
+// most 2^EXEC_RADIX_BITS partitions each, the second pass on up to
+// threads threads at once; the outer tuples are probed EXEC_MORSEL at a
+// time, shared out between the threads. A bloom filter over every build
+// key, an eighth of the pages, turns away the outer tuples without a
+// match before they probe the table or are written to a partition.
+class HashJoin : public Iterator {
+
+  public:
+    HashJoin(Iterator *outer, Iterator *inner, const FieldDesc& outerKey,
+             const FieldDesc& innerKey, int bufPages, int threads = 1);
+    ~HashJoin();
+
+    Status open();
+    Status next(TupleBatch& batch);
+    void   close();
+
+    // outer tuples the bloom filter turned away since open()
+    int    numFiltered()        { return filtered; }
+
+    // pairs of partitions split again, and extra reads of an outer
+    // partition for a pair joined in parts, since open()
+    int    numSplits()          { return splits; }
+    int    numRescans()         { return rescans; }
+
+  private:
+    // the joined tuples found by one thread
+    struct Matches {
+        char  *tuples;
+        int   *lens;
+        int    count;
+        int    capacity;
+    };
+
+    Iterator   *outer;
+    Iterator   *inner;
+    FieldDesc   outerKey;
+    FieldDesc   innerKey;
+    int         bufPages;
+    int         threads;
+
+    // the build tuples and their hashes, in bucket order once the table
+    // is built: bucket b from starts[b] to starts[b + 1]
+    char       *tuples;
+    int        *lens;
+    unsigned   *hashes;
+    int        *starts;
+    int         bucketBits;
+    int         numTuples;
+    int         capacity;
+
+    // where the first pass of the build puts them
+    char       *spare;
+    int        *spareLens;
+    unsigned   *spareHashes;
+    int        *radixStarts;
+    int         radixBits;
+
+    unsigned long long *bloom;
+    unsigned    bloomMask;      // words - 1
+    int         filtered;
+
+    // partitions, NULL when the build side fit in memory; a pair that
+    // was split has NULL files and its parts are added at the end
+    HeapFile  **outerParts;
+    HeapFile  **innerParts;
+    int        *partLevels;
+    int         numParts;
+    int         fanout;         // pairs a split makes
+    int         curPart;
+    Scan       *partScan;
+    bool        partDone;
+    long        tableBudget;    // bytes the table may take
+    int         splits;
+    int         rescans;
+
+    // the rest of the inner partition of a pair joined in parts, and the
+    // tuple that did not fit the table before
+    Scan       *innerScan;
+    char       *carry;
+    int         carryLen;
+
+    TupleBatch  in;
+    char       *morsel;         // the outer tuples being probed
+    int        *morselLens;
+    int         morselCount;
+    Matches    *matches;        // one per thread
+    int         matchSlice;     // the match to return next
+    int         matchPos;
+    bool        outerDone;
+
+    void   clearTable();
+    void   addTuple(const char *tuple, int len, unsigned hash);
+    void   buildTable();
+    void   newPairs(int level);
+    Status splitPair(int part);
+    Status loadPartition(int part);
+    Status loadChunk();
+    Status fillMorsel();
+    static void clusterTask(void *join, int part);
+    static void probeTask(void *join, int slice);
+};
+
+enum AggFunc {
+    AGG_COUNT,
+    AGG_SUM,
+    AGG_MIN,
+    AGG_MAX,
+    AGG_AVG,
+};
+
+// an aggregate of a field of the input; COUNT takes no field
+struct AggSpec {
+    AggFunc   func;
+    FieldDesc field;    // attrInteger or attrReal
+};
+
+// hash GROUP BY: one tuple per distinct value of the n group fields of
+// child, which are packed one after the other and followed by a field
+// per aggregate: COUNT is an int, SUM, MIN and MAX of the type of their
+// field, AVG a float. aggField() says where each is. Groups come out in
+// no particular order.
+//
+// Hybrid hash aggregation: the groups are kept in partitions by the top
+// bits of their hash, a table each, as many as there are pages and at
+// most 2^EXEC_RADIX_BITS. When they grow past bufPages pages (0 for the
+// unpinned frames of the buffer pool) the largest partition is written
+// out to a temporary heap file, and so are the later tuples of its
+// groups, while the other partitions carry on in memory. Each spilled
+// partition is aggregated afterwards on its own, partitioned by a hash
+// with another seed, and may spill again, down to EXEC_MAX_LEVEL levels;
+// groups that still do not fit there, all of one hash, are an error,
+// BAD_EXEC_MEMORY. The input is taken EXEC_MORSEL tuples at a time and
+// up to threads threads work on it, each on partitions of its own.
+class HashAggregate : public Iterator {
+
+  public:
+    HashAggregate(Iterator *child, const FieldDesc *groupBy, int numGroupBy,
+                  const AggSpec *aggs, int numAggs, int bufPages, int threads = 1);
+    ~HashAggregate();
+
+    Status open();
+    Status next(TupleBatch& batch);
+    void   close();
+
+    // where aggregate i lies in the result tuples
+    FieldDesc aggField(int i);
+
+    // partitions written out since open()
+    int    numSpills()          { return spills; }
+
+  private:
+    // a group is an entry: its hash, its count, a value per aggregate and
+    // the group fields. Spilled partitions hold entries too, a tuple
+    // becomes an entry of its own group before it is written.
+    struct Part {
+        char      *entries;
+        int        count;
+        int        capacity;
+        int       *slots;       // entry numbers by hash, -1 for none
+        int        numSlots;
+        HeapFile  *spill;       // its groups are here, if it spilled
+    };
+
+    struct Pending {
+        HeapFile  *file;
+        int        level;
+    };
+
+    Iterator   *child;
+    FieldDesc  *groupBy;
+    int         numGroupBy;
+    AggSpec    *aggs;
+    int         numAggs;
+    int         bufPages;
+    int         threads;
+
+    int         keyLen;
+    int         entrySize;
+    long        budget;
+
+    Part        parts[1 << EXEC_RADIX_BITS];
+    int         partBits;       // hash bits a level of partitions takes
+    int         level;          // of partitions, 0 for the input's
+    Pending    *pending;        // spilled partitions still to aggregate
+    int         numPending;
+    int         spills;
+
+    TupleBatch  in;
+    char       *raw;            // tuples of the input, EXEC_MORSEL at most
+    char       *morsel;         // and as entries
+    int         morselCount;
+    int        *order;          // the morsel by partition
+    int         partStarts[(1 << EXEC_RADIX_BITS) + 1];
+
+    int         emitPart;       // the group to return next
+    int         emitPos;
+
+    void   clearParts();
+    int    partOf(const char *entry);
+    void   merge(Part& part, const char *entry);
+    Status route();
+    Status spillLargest();
+    Status consumeFile(HeapFile *file, int fileLevel);
+    Status finishLevel();
+    void   output(const char *entry, char *tuple);
+    static void convertTask(void *agg, int slice);
+    static void mergeTask(void *agg, int part);
+};
+
+#endif    // _EXECUTOR_H
@@ -0,0 +1,111 @@
+/*
+ * hashfile.h - linear hashing index, the Hash kind of IndexType.
+ *
+ * Buckets are chains of HashBucketPages: a primary page and overflow
+ * pages behind it, holding fixed size <key, rid> entries in no order.
+ * The file starts out with HASH_INITIAL_BUCKETS buckets. Whenever the
+ * entries outgrow HASH_MAX_LOAD percent of the primary pages, the bucket
+ * at the split pointer is split in two and the pointer moves on by one,
+ * so the table grows one bucket at a time and no insert ever rehashes
+ * the whole file. A key hashes to bucket h mod (N << level), or to
+ * h mod (N << (level + 1)) if that bucket has already been split this
+ * round.
+ *
+ * Only equality scans are offered, there is no order to scan in.
+ */
+
+#ifndef _HASHFILE_H
+#define _HASHFILE_H
+
+#include "minirel.h"
+#include "page.h"
+#include "index.h"
+
+class HashFileScan;
+
+// number of buckets of a new file
+#define HASH_INITIAL_BUCKETS 4
+
+// split once the entries fill this many percent of the primary pages
+#define HASH_MAX_LOAD        75
+
+// layout of a bucket page
+struct HashBucketPage
+{
+  PageId nextPage;   // overflow page, INVALID_PAGE at the end of the chain
+  int    count;      // entries on this page
+  char   data[MAX_SPACE - sizeof(PageId) - sizeof(int)];
+};
+
+// layout of a directory page, the bucket -> primary page map is spread
+// over a chain of these
+struct HashDirPage
+{
+  PageId nextPage;
+  PageId buckets[(MAX_SPACE - sizeof(PageId)) / sizeof(PageId)];
+};
+
+class HashFile: public IndexFile
+{
+  friend class HashFileScan;
+
+  public:
+    HashFile(Status& status, const char *filename);
+    // an index with given filename should already exist,
+    // this opens it.
+
+    HashFile(Status& status, const char *filename, const AttrType keytype, const int keysize);
+    // creates a new index
+
+    ~HashFile();
+    // closes index
+
+    Status destroyFile();
+    // destroy entire index file, including the header page and the file entry
+
+    Status insert(const void *key, const RID rid);
+    // add <key,rid> to the key's bucket, splitting the bucket at the
+    // split pointer if the file is now over its load
+
+    Status Delete(const void *key, const RID rid);
+    // delete entry <key,rid>, returns DONE if there is none.
+    // buckets are never merged back.
+
+    HashFileScan *new_scan(const void *key);
+    // create a scan over the entries whose key equals key
+
+    int keysize();
+
+  private:
+    typedef struct headerInfo {
+      PageId headerPid;
+      PageId dirPid;       // first directory page
+      AttrType keyType;
+      int keySize;
+      int level;           // round of splitting, N << level buckets at its start
+      int next;            // split pointer
+      int numBuckets;
+      int numEntries;
+    } headerInfo;
+
+    headerInfo header;     // copy of the header page, see write_header()
+    PageId *buckets;       // primary page of each bucket
+    int capacity;          // room in buckets
+    char *fileName;
+
+    Status write_header();
+    Status write_bucket(int bucket);
+    Status read_directory();
+    int entry_size();
+    int entries_per_page();
+    unsigned int hash(const void *key);
+    int bucket_of(const void *key);
+    int key_equal(const char *entry, const void *key);
+    void make_key(char *entry, const void *key);
+    Status add_entry(PageId pid, const char *entry);
+    Status new_bucket(PageId &pid);
+    Status split();
+    Status free_chain(PageId pid);
+};
+
+#endif
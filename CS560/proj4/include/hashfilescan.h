@@ -0,0 +1,37 @@
+/*
+ * hashfilescan.h - equality scan over a HashFile
+ */
+
+#ifndef _HASHFILESCAN_H
+#define _HASHFILESCAN_H
+
+#include "hashfile.h"
+
+class HashFileScan : public IndexFileScan {
+public:
+    friend class HashFile;
+
+    // get the next entry with the scan's key
+    Status get_next(RID & rid, void* keyptr);
+
+    // delete the entry get_next returned last
+    Status delete_current();
+
+    int keysize(); // size of the key
+
+    // stop after handing out limit more entries
+    void set_limit(int limit);
+
+    // destructor
+    ~HashFileScan();
+private:
+    HashFile *file;
+    char *key;           // the key, padded like the entries
+    PageId curPid;       // page of the entry returned last
+    int curSlot;         // its position on the page, -1 before the first
+    bool scanComplete;
+    int limit;
+    int returned;
+};
+
+#endif
@@ -2,6 +2,8 @@
 #ifndef _HFPAGE_H
 #define _HFPAGE_H
 
+#include <string.h>
+
 #include "minirel.h"
 #include "page.h"
 
@@ -24,7 +26,8 @@ class HFPage {
         short   length;    // equals EMPTY_SLOT if slot is not in use
     };
 
-    static const int DPFIXED =       sizeof(slot_t)
+    static const int DPFIXED =       sizeof(lsn_t)
+                           + sizeof(slot_t)
                            + 4 * sizeof(short)
                            + 3 * sizeof(PageId);
 
@@ -33,6 +36,8 @@ class HFPage {
       // the current implementation to work properly.
       // Be careful when modifying this class.
 
+    lsn_t     lsn;         // last log record applied to the page, see log.h
+
     short     slotCnt;     // number of slots in use
     short     usedPtr;     // offset of first used byte in data[]
     short     freeSpace;   // number of bytes free in data[]
@@ -59,6 +64,9 @@ class HFPage {
 
     PageId page_no() { return curPage;} // returns the page number
 
+    lsn_t getLSN() { return lsn; }      // returns the page LSN
+    void setLSN(lsn_t l) { lsn = l; }   // set by the log manager only
+
     // inserts a new record pointed to by recPtr with length recLen onto
     // the page, returns RID of record 
     Status insertRecord(char *recPtr, int recLen, RID& rid);
@@ -83,6 +91,26 @@ class HFPage {
       // returns the amount of available space on the page
     int    available_space(void);
 
+      // copies the 4 bytes at offset of each record long enough to hold
+      // them into values, in slot order, and its slot number into slots;
+      // returns how many, see pagefilter.h. Inline, so that it is built
+      // optimized with the filter kernels.
+    int    gatherField(int offset, int *values, short *slots)
+    {
+        // the slot array runs on into data[], reach it through a pointer
+        const slot_t *s = (const slot_t *) (const void *) slot;
+        int n = 0;
+        for (int i = 0; i < slotCnt; ++i)
+        {
+            // EMPTY_SLOT is negative
+            if (s[i].length < offset + 4)
+                continue;
+            memcpy(&values[n], &data[s[i].offset + offset], 4);
+            slots[n++] = i;
+        }
+        return n;
+    }
+
       // Returns true if the HFPage is has no records in it, false otherwise.
     bool empty(void);
 
@@ -34,6 +34,11 @@ class IndexFileScan {
 
      virtual int keysize() = 0;
 
+     // hint that the caller wants at most limit more entries, so the
+     // scan can stop pinning pages once it has handed them out.
+     // a limit <= 0 means no limit.
+     virtual void set_limit(int limit) = 0;
+
    private:
      // IndexFile* fileptr;
 
@@ -0,0 +1,184 @@
+/*
+ * lock.h - hierarchical two-phase locking
+ *
+ * Transactions lock files, pages and records in the modes IS, IX, S, SIX
+ * and X. Locking a record first takes IS or IX on its file and page, and
+ * locking a page IS or IX on its file, so a lock on a file conflicts with
+ * any lock inside it without the record locks being looked at. Locks are
+ * held until the transaction ends and calls releaseAll(). A file is
+ * identified by the page id of its header page, as the DB maps its name.
+ *
+ * The lock table is a hash table of lock heads, one per locked file, page
+ * or record, each with its queue of requests. The buckets are split into
+ * LOCK_STRIPES stripes, each with its own latch, so a lock that nobody
+ * else wants costs a latch and an unlatch. A request is granted when it
+ * is compatible with the granted ones and nobody is waiting before it;
+ * an upgrade of a held lock only has to be compatible with the others.
+ *
+ * A transaction holding more record locks in a file than the escalation
+ * threshold has them replaced by one lock on the file, S or X as the
+ * record locks were.
+ *
+ * A request that waits longer than LOCK_WAIT_USEC looks for deadlocks:
+ * the waits-for graph is built with every stripe latched, and in each
+ * cycle the youngest transaction, the one with the highest number, is
+ * picked. Its request fails with LOCK_DEADLOCK; it must roll back and
+ * call releaseAll().
+ *
+ * Up to MINIBASE_MAX_TRANSACTIONS transactions hold locks at a time.
+ * Each runs in one thread at a time; the thread remembers where the
+ * state of its transaction is kept.
+ */
+
+#ifndef _LOCK_H
+#define _LOCK_H
+
+#include <pthread.h>
+
+#include "minirel.h"
+#include "new_error.h"
+
+enum lockErrCodes {
+    LOCK_DEADLOCK,
+    LOCK_TOO_MANY_TXNS,
+    LOCK_BAD_MODE,
+};
+
+enum LockMode {
+    LOCK_NL,        // none
+    LOCK_IS,        // intention to share something inside
+    LOCK_IX,        // intention to update something inside
+    LOCK_S,
+    LOCK_SIX,       // S, and IX
+    LOCK_X,
+};
+
+enum LockLevel {
+    LOCK_FILE,
+    LOCK_PAGE,
+    LOCK_RECORD,
+};
+
+// latches guarding the lock table, a power of 2
+#define LOCK_STRIPES     64
+
+// buckets of the lock table
+#define LOCK_BUCKETS     4096
+
+// record locks in one file a transaction takes before they escalate,
+// by default
+#define LOCK_ESCALATE    1000
+
+// files a transaction counts record locks for
+#define LOCK_MAX_FILES   8
+
+// how long a request waits before it looks for a deadlock
+#define LOCK_WAIT_USEC   2000
+
+// what is locked
+struct LockName {
+    short  level;       // a LockLevel
+    short  unused;
+    PageId file;        // header page of the file
+    PageId pageNo;      // LOCK_PAGE, LOCK_RECORD
+    int    slotNo;      // LOCK_RECORD
+
+    bool operator==(const LockName& n) const
+        { return level == n.level && file == n.file && pageNo == n.pageNo
+                 && slotNo == n.slotNo; }
+};
+
+class LockMgr {
+
+  public:
+
+    LockMgr();
+    ~LockMgr();
+
+    // lock a file, a page of it or a record of it in mode for txn, taking
+    // the intention locks above it, and wait until they are granted
+    Status lockFile(int txn, PageId file, LockMode mode);
+    Status lockPage(int txn, PageId file, PageId pageNo, LockMode mode);
+    Status lockRecord(int txn, PageId file, const RID& rid, LockMode mode);
+
+    // release every lock of txn, at its commit or abort
+    Status releaseAll(int txn);
+
+    // the mode txn holds name in, LOCK_NL for none
+    LockMode held(int txn, const LockName& name);
+
+    // record locks in a file past which they escalate, 0 never to
+    void   setEscalation(int records)  { escalateAt = records; }
+
+    int    numWaits()                  { return waits; }
+    int    numDeadlocks()              { return deadlocks; }
+    int    numEscalations()            { return escalations; }
+
+    static bool     compatible(LockMode a, LockMode b);
+    static LockMode supremum(LockMode a, LockMode b);
+
+  private:
+
+    struct LockHead;
+    struct TxnState;
+
+    struct LockRequest {
+        int          txn;
+        LockMode     mode;        // held, or asked for if not granted
+        LockMode     convertTo;   // a waiting upgrade, else LOCK_NL
+        bool         granted;
+        TxnState    *owner;
+        LockHead    *head;
+        LockRequest *next;        // in the queue of its head
+        LockRequest *txnNext;     // in the list of its transaction
+    };
+
+    struct LockHead {
+        LockName     name;
+        int          counts[LOCK_X + 1];    // granted requests per mode
+        int          waiting;
+        LockRequest *queue;       // granted first, then waiting, in order
+        LockHead    *next;        // in its bucket
+    };
+
+    struct FileCount {
+        PageId file;
+        int    records;
+        bool   exclusive;         // an X record lock among them
+    };
+
+    struct TxnState {
+        int          txn;         // 0 for a free slot
+        LockRequest *locks;
+        LockRequest *waitingOn;   // the request it waits for, if any
+        bool         victim;      // picked to break a deadlock
+        pthread_cond_t cond;
+        FileCount    files[LOCK_MAX_FILES];
+        int          numFiles;
+    };
+
+    LockHead       **buckets;
+    pthread_mutex_t  latches[LOCK_STRIPES];
+    pthread_mutex_t  detectLatch;   // one deadlock search at a time
+    TxnState        *txns;
+    int              escalateAt;
+
+    int              waits;
+    int              deadlocks;
+    int              escalations;
+
+    static unsigned hash(const LockName& name);
+    TxnState *getTxn(int txn, bool create);
+    Status    acquire(TxnState *ts, const LockName& name, LockMode mode,
+                      LockMode *prev);
+    bool      grantable(LockHead *head, LockRequest *req, LockMode mode);
+    void      grantWaiters(LockHead *head);
+    void      release(TxnState *ts, LockRequest *req);
+    Status    countRecord(TxnState *ts, PageId file, LockMode mode);
+    void      detect();
+    bool      waitsNow(int slot);
+    int       blockers(int slot, int *out);
+    bool      search(int slot, char *color, int *path, int depth, int& victim);
+};
+
+#endif    // _LOCK_H
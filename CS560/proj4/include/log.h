@@ -0,0 +1,195 @@
+/*
+ * log.h - write-ahead log and crash recovery
+ *
+ * The log is an append-only file of LogRecords next to the database. An
+ * LSN is the position of a record in the log; it only ever grows, also
+ * across truncations, and every HFPage keeps the LSN of the last change
+ * applied to it in its header.
+ *
+ * Changes to HFPages and SortedPages are logged physically: a PageUpdate
+ * copies the page before an operation and logs the byte ranges that the
+ * operation changed, with their old and new contents. Only changes made
+ * inside a transaction (between begin() and commit() or abort()) are
+ * logged. The buffer manager asks flush() for a page's LSN before it
+ * writes the page out, so no change reaches the database before its log
+ * record reaches the log.
+ *
+ * commit() returns once the commit record is on disk. Committers that
+ * arrive while a flush is in progress wait for the next one, which then
+ * carries all of their records with a single fsync (group commit); the
+ * group commit delay lets the leader of a flush wait for more of them.
+ *
+ * Recovery is ARIES: analysis from the last checkpoint rebuilds the
+ * transaction table and the dirty pages, redo repeats every logged change
+ * that is newer than its page, and undo rolls back the transactions that
+ * did not commit, logging compensation records as it goes.
+ *
+ * Not logged: page allocation and the DB directory, pages that are not
+ * HFPages (B+ tree and hash file headers, hash buckets), and records
+ * changed in place through a pointer from returnRecord().
+ */
+
+#ifndef _LOG_H
+#define _LOG_H
+
+#include <pthread.h>
+
+#include "minirel.h"
+#include "page.h"
+
+class HFPage;
+
+enum logErrCodes {
+    LOG_OPEN_FAILED,
+    LOG_IO_ERROR,
+    LOG_BAD_RECORD,
+    LOG_NO_TXN,
+    LOG_TOO_MANY_TXNS,
+};
+
+enum LogRecType {
+    LOG_BEGIN,
+    LOG_UPDATE,       // a page change, undoable
+    LOG_CLR,          // compensation for an undone change, redo only
+    LOG_COMMIT,
+    LOG_ABORT,
+    LOG_END,          // the transaction is finished with
+    LOG_CHECKPOINT,
+};
+
+// the transactions that can be open at once
+#define LOG_MAX_TXNS 64
+
+// every record starts with this
+struct LogRecord {
+    int    size;        // of the whole record
+    int    unused;
+    lsn_t  lsn;         // its own LSN, to tell records from garbage
+    short  type;        // a LogRecType
+    short  segments;    // UPDATE, CLR: number of LogSegments that follow
+    int    txn;
+    PageId pageId;      // UPDATE, CLR
+    lsn_t  prevLSN;     // previous record of the transaction, 0 for none
+    lsn_t  undoNext;    // CLR: next record of the transaction to undo
+};
+
+// a changed byte range of a page, followed by length bytes before the
+// change and length bytes after it
+struct LogSegment {
+    short  offset;
+    short  length;
+};
+
+class LogMgr {
+
+  public:
+
+    // opens the log, or starts an empty one if create is set. maxLogPages
+    // is the size past which a commit takes a checkpoint.
+    LogMgr(const char *name, int maxLogPages, int create, Status& status);
+
+    // flushes the log
+    ~LogMgr();
+
+    // start a transaction; it becomes the one page changes are logged for
+    int    begin();
+
+    // make txn the one page changes are logged for, 0 for none
+    void   setCurrent(int txn);
+    int    current()                { return curTxn; }
+
+    // whether PageUpdates should log
+    bool   logging()                { return curTxn != 0 && !inRecovery; }
+
+    // log the commit of txn and wait until it is on disk
+    Status commit(int txn);
+
+    // roll txn back
+    Status abort(int txn);
+
+    // log a change to page pid. data is segments LogSegments, each with
+    // its before and after image.
+    Status logUpdate(int txn, PageId pid, int segments, const char *data,
+                     int len, lsn_t& lsn);
+
+    // make sure the log is on disk up to and including lsn
+    Status flush(lsn_t lsn);
+
+    // write a checkpoint. With no transaction open the dirty pages are
+    // written out and the log is emptied.
+    Status checkpoint();
+
+    // analysis, redo and undo; done when an existing database is opened
+    Status recover();
+
+    // microseconds the leader of a group commit waits for more commits
+    void   setGroupCommitDelay(int usec) { groupDelay = usec; }
+
+    // the LSN the next record gets
+    lsn_t  endLSN()                 { return tail; }
+
+    // commits and fsyncs so far
+    int    numCommits()             { return commits; }
+    int    numSyncs()               { return syncs; }
+
+  private:
+
+    struct TxnEntry {
+        int   txn;
+        lsn_t lastLSN;
+        short state;        // LOG_BEGIN while running, LOG_COMMIT, LOG_ABORT
+    };
+
+    int      fd;
+    lsn_t    base;          // LSN of the first byte after the file header
+    lsn_t    checkpointLSN; // last checkpoint, 0 for none
+    lsn_t    flushedLSN;    // everything before it is on disk
+    lsn_t    tail;          // LSN the next record gets
+    long     maxLogSize;
+
+    char    *buf;           // the records from flushedLSN to tail
+    int      bufCap;
+
+    TxnEntry txns[LOG_MAX_TXNS];
+    int      numTxns;
+    int      nextTxn;
+    int      curTxn;
+    bool     inRecovery;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t  flushed;
+    bool     flushing;      // a leader is writing the log
+    int      groupDelay;
+    int      commits;
+    int      syncs;
+
+    Status writeHeader();
+    Status append(LogRecord& rec, const char *body, int bodyLen, lsn_t& lsn);
+    Status waitFlushed(lsn_t lsn);
+    Status readRecord(lsn_t lsn, LogRecord& rec, char *&body);
+    TxnEntry *findTxn(int txn);
+    Status endTxn(int txn);
+    Status undo(lsn_t *toUndo, int *owners, int n);
+    Status applySegments(PageId pid, const char *body, int segments,
+                         lsn_t lsn, bool checkLSN);
+};
+
+// logs what one page operation changes, see above. Operations nest, a
+// SortedPage one calling an HFPage one; only the outermost logs. A page
+// being formatted logs all of it, since what the buffer frame held
+// before need not be what is on disk.
+class PageUpdate {
+
+  public:
+    PageUpdate(HFPage *page, bool wholePage = false);
+    ~PageUpdate();
+
+  private:
+    HFPage *page;
+    char   *before;     // copy of the page, NULL if not logging
+    bool    wholePage;
+
+    static int depth;
+};
+
+#endif    // _LOG_H
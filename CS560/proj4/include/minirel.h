@@ -20,6 +20,7 @@ enum SelectType { selRange, selExact, selBoth, selUndefined };
 
 
 typedef int PageId;
+typedef long long lsn_t; // log sequence number, the position of a log record
 
 struct RID{
 	PageId  pageNo;
@@ -30,6 +31,12 @@ struct RID{
 	  {return pageNo!=rid.pageNo || slotNo!=rid.slotNo;};
 };
 
+// a record that moved, see HeapFile::vacuum()
+struct RidMove{
+	RID  oldRid;
+	RID  newRid;
+};
+
 
 const int MINIBASE_PAGESIZE = 1024;           // in bytes
 const int MINIBASE_BUFFER_POOL_SIZE = 1024;   // in Frames
@@ -0,0 +1,56 @@
+/*
+ * pagefilter.h - simple predicates evaluated a page at a time
+ *
+ * A PagePredicate compares a 4-byte integer or real field at a fixed
+ * offset in each record with constants: equal, less, greater, or within
+ * a range, both ends included. filterPage() evaluates one on every
+ * record of an HFPage at once. The field of each record is gathered
+ * through the slot array into a dense vector, which is compared eight
+ * values at a time with AVX2, four with SSE2, or one at a time,
+ * whichever the CPU has. The result is a bitmap with a bit set for each
+ * slot whose record matches. Records too short to hold the field never
+ * match.
+ */
+
+#ifndef _PAGEFILTER_H
+#define _PAGEFILTER_H
+
+#include "minirel.h"
+#include "tuple.h"
+
+class HFPage;
+
+// the most slots on a page, and the words of a bitmap with a bit each
+#define FILTER_MAX_SLOTS    (MINIBASE_PAGESIZE / 4)
+#define FILTER_BITMAP_WORDS ((FILTER_MAX_SLOTS + 31) / 32)
+
+enum FilterKernel {
+    FILTER_SCALAR,
+    FILTER_SSE,
+    FILTER_AVX2,
+};
+
+struct PagePredicate {
+    AttrOperator op;    // aopEQ, aopLT, aopGT or aopRANGE
+    FieldDesc    field; // attrInteger or attrReal, 4 bytes
+    const void  *lo;    // the value compared with; the low end of aopRANGE
+    const void  *hi;    // the high end of aopRANGE
+};
+
+// whether pred is one filterPage() can evaluate
+bool predicateValid(const PagePredicate& pred);
+
+// whether the record rec of len bytes satisfies pred
+bool evalPredicate(const PagePredicate& pred, const char *rec, int len);
+
+// sets bit s of bitmap, of FILTER_BITMAP_WORDS words, for each slot s of
+// page whose record satisfies pred and clears the others; returns how
+// many are set
+int filterPage(HFPage *page, const PagePredicate& pred, unsigned *bitmap);
+
+// the kernel filterPage() uses, the best the CPU has unless a lower one
+// was set, to compare them
+FilterKernel filterKernel();
+void         setFilterKernel(FilterKernel kernel);
+
+#endif    // _PAGEFILTER_H
@@ -0,0 +1,92 @@
+/*
+ * pageio.h - asynchronous page reads and writes on io_uring
+ *
+ * DB::read_page() and write_page() are one blocking system call per
+ * page. A PageIO opens the DB file again and puts page reads and writes
+ * on an io_uring instead. Requests are queued, handed to the kernel with
+ * one system call by submit(), and collected with complete(), so many
+ * are in flight at once. A request may also cover a run of consecutive
+ * pages.
+ *
+ * Memory given to the constructor, normally the buffer pool, is
+ * registered with the kernel. Requests for pages inside it use fixed
+ * buffers, so the kernel does not map and pin the user pages on every
+ * request. Other memory works too, through ordinary requests. If the
+ * kernel refuses the registration, every request is an ordinary one.
+ *
+ * The buffer manager drives one for read-ahead and background flushing,
+ * see BufMgr::enableAsyncIO(). A bulk loader opens its own to write the
+ * pages it allocated. The file is the same one DB uses and both go
+ * through the page cache, so they see each other's writes; a page must
+ * not be written by both at the same time.
+ */
+
+#ifndef _PAGEIO_H
+#define _PAGEIO_H
+
+#include "minirel.h"
+#include "page.h"
+
+// a request that has completed
+struct PageIODone {
+    long tag;           // given when it was queued
+    int  result;        // bytes moved, or -errno
+};
+
+class PageIO {
+
+  public:
+
+    // opens the DB file dbname for up to depth requests in flight, with
+    // the numPages pages at pool registered, if pool is not NULL
+    PageIO(const char *dbname, int depth, Page *pool, int numPages, Status& status);
+
+    // waits for the requests in flight
+    ~PageIO();
+
+    // queue a read of the n pages from pid into pages, or a write of
+    // them; tag comes back with the completion. Fails with BUFFERAIOFULL
+    // once depth requests are queued or in flight.
+    Status queueRead(PageId pid, Page *pages, long tag, int n = 1);
+    Status queueWrite(PageId pid, const Page *pages, long tag, int n = 1);
+
+    // hand the queued requests to the kernel
+    Status submit();
+
+    // wait until at least min requests have completed, submitting the
+    // queued ones first, and fill in up to max of them in done. Returns
+    // how many, -1 if waiting failed.
+    int    complete(PageIODone *done, int max, int min);
+
+    int    depth()              { return maxInFlight; }
+    int    queued()             { return numQueued; }
+    int    inFlight()           { return numInFlight; }
+    bool   fixedBuffers()       { return registered; }
+
+  private:
+    int       ringFd;
+    int       fd;
+    int       maxInFlight;
+    int       numQueued;        // not submitted yet
+    int       numInFlight;      // queued or submitted, not completed
+    bool      registered;
+    char     *poolStart;
+    char     *poolEnd;
+
+    // the rings shared with the kernel
+    void     *sqRing;
+    size_t    sqRingSize;
+    void     *cqRing;
+    size_t    cqRingSize;
+    struct io_uring_sqe *sqes;
+    size_t    sqesSize;
+
+    unsigned *sqHead, *sqTail, *sqMask, *sqArray;
+    unsigned *cqHead, *cqTail, *cqMask;
+    struct io_uring_cqe *cqes;
+
+    Status queue(int op, int fixedOp, PageId pid, const Page *pages, long tag, int n);
+    void   close();
+};
+
+#endif    // _PAGEIO_H
@@ -0,0 +1,86 @@
+/*
+ * pagezip.h - compressed page store
+ *
+ * Pages of files that are switched to compression are not written to the
+ * DB file but, compressed, to a store file next to it, dbname-z. The
+ * store is cut into units of ZIP_UNIT bytes and a page takes as many
+ * consecutive units as it needs; the indirection map, dbname-zmap, has
+ * one Slot per DB page giving its units. A rewritten page always goes
+ * to a new slot and the old one is freed after the map points to the new
+ * one, so a page is never half overwritten.
+ *
+ * The buffer manager reads and writes through a PageZip for the pages it
+ * holds (see BufMgr::enableCompression()); frames in the pool are always
+ * uncompressed. The codec is a small LZ77 in the style of LZ4: literal
+ * runs and matches of at least four bytes at most 64K back.
+ */
+
+#ifndef _PAGEZIP_H
+#define _PAGEZIP_H
+
+#include "minirel.h"
+#include "page.h"
+
+// allocation unit of the store
+#define ZIP_UNIT      64
+#define ZIP_MAX_UNITS (MINIBASE_PAGESIZE / ZIP_UNIT)
+
+// compress len bytes of in to out, which has room for cap bytes.
+// Returns the compressed length, -1 if it does not fit.
+int zipCompress(const char *in, int len, char *out, int cap);
+
+// decompress inLen bytes of in to the len bytes of out. Returns len, or
+// -1 if in is damaged.
+int zipDecompress(const char *in, int inLen, char *out, int len);
+
+class PageZip {
+
+  public:
+
+    // opens the store of the DB dbname, or starts an empty one
+    PageZip(const char *dbname, int numPages, Status& status);
+    ~PageZip();
+
+    // whether pid belongs to a compressed file
+    bool   compressed(PageId pid)   { return pid >= 0 && pid < numPages && slots[pid].units >= 0; }
+
+    // switch pid to compression, or back; a page switched back is moved
+    // to the DB file
+    Status setCompressed(PageId pid, bool on);
+
+    // forget pid without moving it, for pages that are freed
+    Status drop(PageId pid);
+
+    // pages of compressed files that have not been written yet are still
+    // in the DB file and are read from there
+    Status read(PageId pid, Page *page);
+    Status write(PageId pid, Page *page);
+
+    // pages in the store and the bytes they take there
+    int    storedPages();
+    long   storedBytes();
+
+  private:
+    struct Slot {
+        int   offset;   // in units
+        short units;    // -1 if the page is not compressed, 0 if not stored
+        short length;   // compressed bytes, MINIBASE_PAGESIZE if stored raw
+    };
+
+    int    fd;
+    int    mapFd;
+    int    numPages;
+    Slot  *slots;
+    int    endUnit;     // units in the store file
+
+    // free slots by size, freeSlots[n] holds offsets of n units
+    int   *freeSlots[ZIP_MAX_UNITS + 1];
+    int    numFree[ZIP_MAX_UNITS + 1];
+    int    capFree[ZIP_MAX_UNITS + 1];
+
+    Status saveSlot(PageId pid);
+    void   freeSlot(int offset, int units);
+    int    allocSlot(int units);
+};
+
+#endif    // _PAGEZIP_H
@@ -0,0 +1,132 @@
+/*
+ * class Scan
+ * $Id: scan.h,v 1.1 1997/01/02 12:46:43 flisakow Exp $
+ */
+
+#ifndef _SCAN_H_
+#define _SCAN_H_
+
+#include "minirel.h"
+#include "pagefilter.h"
+
+// ***********************************************************
+// A Scan object is created ONLY through the function openScan
+// of a HeapFile. It supports the getNext interface which will
+// simply retrieve the next record in the heapfile.
+//
+// An object of type scan will always have pinned one directory page
+// of the heapfile.
+
+class HeapFile;
+class HFPage;
+struct Snapshot;
+
+class Scan {
+
+  public:
+    // The constructor pins the first page in the file
+    // and initializes its private data members from the private
+    // data members from hf. Under a snapshot, the file is seen as it
+    // was when the snapshot was taken, see version.h.
+    Scan(HeapFile *hf, Status& status, Snapshot *snapshot = NULL);
+   ~Scan();
+
+    // Retrieve the next record in a sequential scan
+    // Also returns the RID of the retrieved record.
+    Status getNext(RID& rid, char *recPtr, int& recLen);
+
+    // From the first getNext() on, return only the records that satisfy
+    // pred. Each data page is filtered as a whole when the scan gets to
+    // it, see pagefilter.h; under a snapshot records are tested one by one.
+    Status setFilter(const PagePredicate& pred);
+
+    // Position the scan cursor to the record with the given rid.
+    // Returns OK if successful, non-OK otherwise.
+    Status position(RID rid);
+
+  private:
+    /*
+     * See heapfile.h for the overall description of a heapfile.
+     * (Then see hfpage.h for HFPage ops.)
+     */
+
+    // The heapfile we are using.
+    HeapFile  *_hf;
+
+    // PageId of current directory page (which is itself an HFPage)
+    // (the actual PageId of the dir page with current position)
+    PageId dirPageId;
+    
+    // the actual PageId of the data page with the current record
+    PageId dataPageId;
+
+    // record ID of the DataPageInfo struct (in the directory page) which
+    // describes the data page where our current record lives.
+    // (the rid of the data page)
+    RID dataPageRid;
+
+    // pointer to in-core data of dirpageId (page is pinned) 
+    HFPage *dirPage;
+
+    // in-core copy (pinned) of the same
+    HFPage *dataPage;
+
+    // record ID of the current record (from the current data page)
+    RID     userRid;
+
+    // flag for whether to check scan is done (0 or 1)
+    int     scanIsDone; // (may not be used)
+
+    // status value of whether next record exists
+    int     nxtUserStatus;
+
+    // the snapshot the scan reads, NULL for none
+    Snapshot *snap;
+
+    // under a snapshot or a filter, the slot on dataPage last returned,
+    // -1 for none
+    int     lastSlot;
+
+    // the predicate of a filtered scan, with copies of its constants
+    bool          filtered;
+    PagePredicate filter;
+    int           filterBounds[2];
+
+    // the slots of page matchesPage whose records satisfy filter
+    unsigned      matches[FILTER_BITMAP_WORDS];
+    PageId        matchesPage;
+
+    // Do all the constructor work
+    Status init(HeapFile *hf);
+
+    // Reset everything and unpin all pages.
+    Status reset();
+
+    // Move over the data pages in the file (firstDataPage(), nextDataPage())
+
+    // Get the first data pages in the file
+    Status firstDataPage();
+    // Get next data page
+    Status nextDataPage();
+
+    // Get next directory page
+    Status nextDirPage();
+
+    // Look ahead the next record
+    Status peekNext(RID& rid) {
+        rid = userRid;
+        return OK;
+    }
+
+    // Move to the next record in a sequential scan.
+    // Also returns the RID of the (new) current record.
+    Status mvNext(RID& rid);
+
+    // getNext() under a snapshot
+    Status nextVisible(RID& rid, char *recPtr, int& recLen);
+
+    // getNext() with a filter and no snapshot
+    Status nextMatching(RID& rid, char *recPtr, int& recLen);
+};
+
+#endif  // _SCAN_H
@@ -0,0 +1,80 @@
+/*
+ * spacemap.h - page allocation over the DB space map
+ *
+ * The DB keeps one bit per page on the space map pages that start at
+ * page 1, and DB::allocate_page() looks for a run of free pages by reading
+ * the bits from the beginning every time. SpaceMap reads the bits once
+ * and keeps a segment tree over them in memory: every node of the tree
+ * knows the longest run of free pages below it and the free runs at its
+ * two ends, so the first run of n free pages at or after a given page is
+ * found in O(log pages).
+ *
+ * Allocation takes a hint, a page the new pages should lie close to (the
+ * page before them in a heap file, the page being split in a B+ tree),
+ * and searches forward from there before wrapping around to page 0, so a
+ * file grows along consecutive pages where it can. The bits are written
+ * through the buffer manager, the same way the DB writes them, so both
+ * can be used on the same database; pages the DB allocates behind
+ * SpaceMap's back (its directory pages) are noticed when SpaceMap finds
+ * their bits set.
+ *
+ * The pages of a tablespace (see tablespace.h) follow those of the DB
+ * file, with their bits in the tablespace. When no run is free, a
+ * database with a tablespace grows by new segments instead of failing
+ * with DB_FULL.
+ */
+
+#ifndef _SPACEMAP_H
+#define _SPACEMAP_H
+
+#include "minirel.h"
+#include "db.h"
+
+class SpaceMap {
+
+  public:
+
+    // reads the space map of MINIBASE_DB
+    SpaceMap(Status& status);
+    ~SpaceMap();
+
+    // allocate runSize consecutive pages, the first one at or after hint
+    // if there is room there, else the first run in the database
+    Status allocate(PageId& start, int runSize = 1, PageId hint = INVALID_PAGE);
+
+    // free runSize pages from start on
+    Status deallocate(PageId start, int runSize = 1);
+
+    // pages not allocated
+    int    numFree()                { return freePages; }
+
+    // pages in the database, in the DB file and in its segments
+    int    pages()                  { return numPages; }
+
+    // fill in the allocated pages in order, as the bits on disk have
+    // them, and their number n; pids has room for pages()
+    Status listAllocated(PageId *pids, int& n);
+
+  private:
+    int   dbPages;      // in the DB file
+    int   numPages;     // in the database
+    int   size;         // leaves of the tree, numPages rounded up to 2^k
+    int   freePages;
+
+    // per tree node, node 1 is the root and node i has children 2i and
+    // 2i+1; the leaves are size .. 2*size-1
+    int  *maxRun;       // the longest run of free pages
+    int  *prefix;       // free pages at the start
+    int  *suffix;       // free pages at the end
+
+    void   mark(PageId start, int runSize, bool free);
+    void   combine(int node, int childLen);
+    void   build();
+    void   resize(int pages);
+    int    search(int node, int lo, int hi, int from, int runSize, int& carry);
+    int    find(int from, int runSize);
+    Status readBits(PageId start, int runSize, int& firstSet);
+    Status writeBits(PageId start, int runSize, int bit);
+};
+
+#endif    // _SPACEMAP_H
@@ -15,6 +15,11 @@
 class BufMgr;
 class DB;
 class Catalog;
+class LogMgr;
+class SpaceMap;
+class LockMgr;
+class VersionStore;
+class Tablespace;
 
 #define MINIBASE_MAXARRSIZE 50
 
@@ -52,12 +57,37 @@ public:
     DB*                 GlobalDB;
     Catalog*            GlobalCatalogPtr;
       /* The global catalog object is declared here, but not allocated by the
-         SystemDefs constructor.  If you need to use the catalog, use the
-         ExtendedSystemDefs constructor, declared in ext_sys_defs.h. */
+         SystemDefs constructor: databases that never use it get no catalog
+         files. It is opened by the first MINIBASE_CATALOG, see catalog.h. */
 
     char*               GlobalDBName;
     char*               GlobalLogName;
 
+      /* The write-ahead log, see log.h, and the page allocator, see
+         spacemap.h. Kept last, the DB library was built against the
+         members above. */
+    LogMgr*             GlobalLogMgr;
+    SpaceMap*           GlobalSpaceMap;
+
+      /* The lock manager, see lock.h; transactions take their locks
+         from it themselves. */
+    LockMgr*            GlobalLockMgr;
+
+      /* Old record versions for snapshot scans, see version.h. */
+    VersionStore*       GlobalVersionStore;
+
+      /* The segment files past the end of the DB file, see
+         tablespace.h; NULL for a database that is one file. */
+    Tablespace*         GlobalTablespace;
+
+    Catalog* getCatalog();
+
+    Status addTablespace( const char** dirs, int numDirs, int segPages =0 );
+      /* Let the database grow past its DB file, into segment files spread
+         over the numDirs directories dirs, or next to the DB file if
+         numDirs is 0. Segments are of segPages pages, TS_SEGMENT_PAGES
+         if 0. */
+
 protected:
     void init( Status& status, const char* dbname, const char* logname,
                unsigned dbpages, unsigned maxlogsize,
@@ -68,6 +98,12 @@ extern SystemDefs* minibase_globals;
 
 #define  MINIBASE_DB                    (minibase_globals->GlobalDB)
 #define  MINIBASE_BM                    (minibase_globals->GlobalBufMgr)
+#define  MINIBASE_LOG                   (minibase_globals->GlobalLogMgr)
+#define  MINIBASE_SPACEMAP              (minibase_globals->GlobalSpaceMap)
+#define  MINIBASE_LOCK                  (minibase_globals->GlobalLockMgr)
+#define  MINIBASE_VERSIONS              (minibase_globals->GlobalVersionStore)
+#define  MINIBASE_TABLESPACE            (minibase_globals->GlobalTablespace)
+#define  MINIBASE_CATALOG               (minibase_globals->getCatalog())
 
 
 #define  MINIBASE_DBNAME                (minibase_globals->GlobalDBName)
@@ -0,0 +1,89 @@
+/*
+ * tablespace.h - a database spread over segment files
+ *
+ * A DB is one file of a size fixed when it was created. A Tablespace adds
+ * pages after the last page of the DB file, in segment files of a fixed
+ * number of pages each, so the database can grow past it. Page pid lies
+ * in segment (pid - firstPage()) / segmentPages(), at offset
+ * (pid - firstPage()) % segmentPages() in it. Segments are created as the
+ * space map runs out of free pages (see SpaceMap::allocate()), and they
+ * are spread round robin over a list of directories, which may be on
+ * different disks, so a run of pages longer than a segment is read and
+ * written across all of them. Segment k of the DB dbname is the file
+ * dbname-seg<k>, or dir/<name>-seg<k> for the k mod n'th of n
+ * directories, where name is the last component of dbname.
+ *
+ * The pages of the segments have their allocation bits in the control
+ * file, dbname-ts, which also lists the directories; its bits are written
+ * as soon as they change, and sync() forces them and the segments to disk
+ * (a checkpoint does, before it starts the log over). The buffer manager
+ * reads and writes pages in a segment through the Tablespace of the
+ * database, MINIBASE_TABLESPACE, which is opened with it if the control
+ * file exists. Pages in segments are neither checksummed nor compressed,
+ * and they are read and written one at a time even with asynchronous I/O.
+ */
+
+#ifndef _TABLESPACE_H
+#define _TABLESPACE_H
+
+#include "minirel.h"
+#include "page.h"
+
+// pages per segment unless given, and the most directories
+#define TS_SEGMENT_PAGES 4096
+#define TS_MAX_DIRS      8
+#define TS_MAX_PATH      256
+
+class Tablespace {
+
+  public:
+
+    // writes the control file of a tablespace of the DB dbname, with no
+    // segments yet; firstPage is the number of pages of the DB file.
+    // segPages is rounded up to a multiple of 32.
+    static Status create(const char *dbname, int firstPage, const char **dirs,
+                         int numDirs, int segPages = TS_SEGMENT_PAGES);
+
+    // opens the tablespace of the DB dbname and its segments
+    Tablespace(const char *dbname, int firstPage, Status& status);
+    ~Tablespace();
+
+    bool   contains(PageId pid)     { return pid >= base && pid < end; }
+    PageId firstPage()              { return base; }
+    PageId endPage()                { return end; }
+    int    numSegments()            { return numSegs; }
+    int    segmentPages()           { return segPages; }
+    int    numDirs()                { return numDirectories; }
+
+    // add segments, enough for minPages more pages
+    Status grow(int minPages);
+
+    // the allocation bit of a page in a segment
+    bool   allocated(PageId pid)    { return (bits[(pid - base) / 8] >> ((pid - base) % 8)) & 1; }
+    Status setAllocated(PageId start, int runSize, bool on);
+
+    // a page that was never written reads as zeros
+    Status read(PageId pid, Page *page);
+    Status write(PageId pid, Page *page);
+
+    // writes and bit changes reach the disk only with this, except that
+    // grow() syncs the segments it adds
+    Status sync();
+
+  private:
+    char  *dbname;
+    int    ctlFd;
+    PageId base;
+    PageId end;
+    int    segPages;
+    int    numSegs;
+    int    numDirectories;
+    char   dirs[TS_MAX_DIRS][TS_MAX_PATH];
+    int   *fds;             // per segment
+    unsigned char *bits;    // per page of the segments
+
+    // the file of segment seg, malloced
+    char  *segmentName(int seg);
+};
+
+#endif    // _TABLESPACE_H
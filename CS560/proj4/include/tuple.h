@@ -0,0 +1,187 @@
+/*
+ * tuple.h - records laid out by a schema
+ *
+ * Heap files store records as uninterpreted bytes. A Schema gives them
+ * fields: an attrInteger or attrReal of 4 bytes, a fixed attrString of
+ * len bytes, or a varlen attrString of at most len bytes. Any field may
+ * be null.
+ *
+ * A tuple starts with the null bitmap, bit i of byte i / 8 set if field
+ * i is null. The fixed fields follow in schema order, at offsets the
+ * schema computes once, so reading one is a pointer add; a null fixed
+ * field keeps its bytes, zeroed. Then comes an array of 2-byte end
+ * offsets, one per varlen field, and the varlen values back to back:
+ * varlen field v runs from the end of field v - 1, or from the end of
+ * the array for the first, to its own end. A null varlen field is empty.
+ *
+ * Since a fixed field always sits at the same offset, fieldDesc() hands
+ * it to the executor as is, and index keys are read in place.
+ */
+
+#ifndef _TUPLE_H
+#define _TUPLE_H
+
+#include <string.h>
+
+#include "minirel.h"
+
+// the most fields in a schema
+#define SCHEMA_MAX_FIELDS 64
+
+// where a field lies in a tuple
+struct FieldDesc {
+    AttrType type;      // attrInteger, attrReal or attrString
+    int      offset;
+    int      len;
+};
+
+// a field of a schema
+struct FieldDef {
+    AttrType type;      // attrInteger, attrReal or attrString
+    int      len;       // of a string; the most a varlen one holds
+    bool     varlen;    // strings only
+};
+
+class Schema {
+
+  public:
+
+    Schema(const FieldDef *fields, int n, Status& status);
+    ~Schema();
+
+    int  numFields()                    { return n; }
+    const FieldDef& field(int i)        { return fields[i]; }
+    bool isVarlen(int i)                { return fields[i].varlen; }
+
+    // the bytes of a tuple with every varlen field empty, and the most
+    int  minLen()                       { return dataStart; }
+    int  maxLen()                       { return maxLength; }
+
+    // the bytes of tuple t
+    int  length(const char *t)          { return numVar ? end(t, numVar - 1) : dataStart; }
+
+    bool isNull(const char *t, int i)   { return (t[i >> 3] >> (i & 7)) & 1; }
+
+    // fixed field i of t
+    const char *fixed(const char *t, int i) { return t + pos[i]; }
+
+    int getInt(const char *t, int i)
+    {
+        int v;
+        memcpy(&v, t + pos[i], sizeof(int));
+        return v;
+    }
+
+    float getReal(const char *t, int i)
+    {
+        float v;
+        memcpy(&v, t + pos[i], sizeof(float));
+        return v;
+    }
+
+    // varlen field i of t, len bytes long
+    const char *varlen(const char *t, int i, int& len)
+    {
+        int v = pos[i];
+        int start = v ? end(t, v - 1) : dataStart;
+        len = end(t, v) - start;
+        return t + start;
+    }
+
+    // the end of varlen field v of t
+    int end(const char *t, int v)
+    {
+        unsigned short e;
+        memcpy(&e, t + endsAt + 2 * v, sizeof(e));
+        return e;
+    }
+
+    // whether the len bytes at t can be read as a tuple of this schema
+    bool valid(const char *t, int len);
+
+    // where fixed field i lies, for the executor
+    FieldDesc fieldDesc(int i);
+
+  private:
+    friend class Tuple;
+    friend class Projection;
+
+    FieldDef *fields;
+    int       n;
+    int      *pos;          // the offset of a fixed field, the number
+                            // among the varlen fields of a varlen one
+    int       numVar;
+    int       endsAt;       // where the array of varlen ends starts
+    int       dataStart;    // and where it ends
+    int       maxLength;
+};
+
+// a tuple being built, in a buffer of the schema's maxLen() bytes
+class Tuple {
+
+  public:
+
+    // with every field null
+    Tuple(Schema *schema);
+    ~Tuple();
+
+    void   clear();
+
+    Status setInt(int i, int v);
+    Status setReal(int i, float v);
+    // a fixed string shorter than the field is padded with zeros
+    Status setString(int i, const char *s, int len);
+    void   setNull(int i);
+
+    Schema *schema()                    { return s; }
+    char   *data()                      { return buf; }
+    int     length()                    { return s->length(buf); }
+
+    // a copy of the len bytes at t, which must be valid()
+    Status load(const char *t, int len);
+
+  private:
+    Schema *s;
+    char   *buf;
+
+    Status  checkField(int i, AttrType type);
+    void    setVar(int i, const char *value, int len);
+};
+
+// copies some of the fields of a tuple into a tuple of another schema.
+// It is compiled once into runs of fixed fields: fields next to each
+// other in the input that stay next to each other in the output are
+// copied with one memcpy.
+class Projection {
+
+  public:
+
+    // the output has fields fields[0..n-1] of in, in that order
+    Projection(Schema *in, const int *fields, int n, Status& status);
+    ~Projection();
+
+    // the schema of the output, owned by the projection
+    Schema *result()                    { return out; }
+    int     numRuns()                   { return numCopies; }
+
+    // project t into to, which has room for result()->maxLen() bytes;
+    // returns the length of the output
+    int     apply(const char *t, char *to);
+
+  private:
+    struct Run {
+        int from;           // offset in the input
+        int to;             // and in the output
+        int len;
+    };
+
+    Schema *in;
+    Schema *out;
+    int    *fields;
+    int     n;
+    Run    *runs;
+    int     numCopies;
+    int    *varFrom;        // the input field of each output varlen field
+};
+
+#endif    // _TUPLE_H
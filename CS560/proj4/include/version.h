@@ -0,0 +1,134 @@
+/*
+ * version.h - old record versions for snapshot scans
+ *
+ * Heap files are updated in place. The version store keeps what each
+ * change overwrote, so that a scan under a snapshot sees every record as
+ * it was when the snapshot was taken: it neither waits for writers nor
+ * sees their uncommitted or later changes, and takes no locks.
+ *
+ * Timestamps come from one counter: a snapshot gets its current value,
+ * each commit the next one. A version is a record as it was before a
+ * change: it begins at the commit of the version before it and ends at
+ * the commit of the change that replaced it, or has no end yet while that
+ * change is uncommitted. The record in the heap file is the newest
+ * version. An insert saves a version with no record, a delete one with
+ * the deleted record, so deleted records stay visible to older snapshots.
+ * A change made outside a transaction commits at once.
+ *
+ * Versions are only kept while a snapshot is open or the change belongs
+ * to an open transaction. collect() drops those no open snapshot can see;
+ * it runs when the oldest snapshot is closed, and the versions of a
+ * transaction go at its commit if no snapshot is open.
+ *
+ * The store is in memory, snapshots do not outlive the database being
+ * open. RIDs must stay put while a snapshot is open: no vacuum.
+ */
+
+#ifndef _VERSION_H
+#define _VERSION_H
+
+#include "minirel.h"
+#include "log.h"
+
+// buckets of the version store, by file and page
+#define VERSION_BUCKETS 4096
+
+struct Snapshot {
+    long long ts;           // changes committed after it are not seen
+    Snapshot *prev;         // open snapshots, oldest first
+    Snapshot *next;
+};
+
+// where a record as of a snapshot is
+enum VersionView {
+    VIEW_CURRENT,           // in the heap file
+    VIEW_OLD,               // in the version store
+    VIEW_NONE,              // it did not exist
+};
+
+class VersionStore {
+
+  public:
+
+    VersionStore();
+    ~VersionStore();
+
+    Snapshot *openSnapshot();
+    void      closeSnapshot(Snapshot *snap);
+
+    // whether a change made by txn is versioned: a snapshot is open, or
+    // txn is a transaction and not 0
+    bool      keeping(int txn);
+    bool      snapshotsOpen()       { return oldest != NULL; }
+
+    // called by HeapFile once a record was inserted at rid, and before
+    // the record at rid, old, is updated or deleted. txn made the change,
+    // 0 for none; file is the header page of the heap file.
+    void      recordInsert(int txn, PageId file, const RID& rid);
+    void      recordChange(int txn, PageId file, const RID& rid,
+                           const char *old, int len, bool deleted);
+
+    // the record at rid as snap sees it. For VIEW_OLD data and len are
+    // the record, owned by the store and valid until it changes.
+    VersionView view(PageId file, const RID& rid, const Snapshot *snap,
+                     const char *&data, int& len);
+
+    // the first slot after afterSlot on page pageNo of file whose record
+    // was deleted but has versions; false if there is none
+    bool      nextDeleted(PageId file, PageId pageNo, int afterSlot, RID& rid);
+
+    // stamp or drop the versions of a transaction, called by LogMgr
+    void      commit(int txn);
+    void      abort(int txn);
+
+    // drop the versions no open snapshot can see; returns how many
+    int       collect();
+
+    int       numVersions()         { return versions; }
+    long      storedBytes()         { return stored; }
+
+  private:
+
+    struct Chain;
+
+    struct Version {
+        long long endTs;      // 0 while the change is uncommitted
+        int       txn;        // of the change, 0 for none
+        int       len;        // of the record, -1 for none
+        bool      prevAbsent; // the chain's absent before the change
+        char     *data;
+        Version  *older;
+        Version  *txnNext;    // in the list of an open transaction
+        Chain    *chain;
+    };
+
+    // the versions of one record, newest first
+    struct Chain {
+        PageId    file;
+        RID       rid;
+        bool      absent;     // the record is deleted from the heap file
+        Version  *newest;
+        Chain    *next;       // in its bucket
+    };
+
+    struct TxnVersions {
+        int       txn;        // 0 for a free entry
+        Version  *versions;   // newest first
+    };
+
+    Chain      **buckets;
+    TxnVersions  txns[LOG_MAX_TXNS];
+    Snapshot    *oldest, *newest;
+    long long    clock;
+    int          versions;
+    long         stored;
+
+    static unsigned hash(PageId file, PageId pageNo);
+    Chain  *find(PageId file, const RID& rid, bool create);
+    void    push(int txn, PageId file, const RID& rid, const char *data,
+                 int len, bool absentAfter);
+    void    unlink(Version *v);
+    TxnVersions *findTxn(int txn, bool create);
+};
+
+#endif    // _VERSION_H